@@ -0,0 +1,158 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file alignedAllocator.h
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Allocator of memory aligned to a cache line and optionally backed by huge pages
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+#ifndef ALIGNEDALLOCATOR_H
+#define ALIGNEDALLOCATOR_H
+
+/********************************* Includes *******************************/
+#include <stdlib.h>
+#include <sys/mman.h>
+
+#include <new>
+#include <string>
+#include <vector>
+
+/******************************** Constants *******************************/
+const size_t MEMORY_ALIGNMENT = 64;            /**< Bytes of the alignment, a cache line and an AVX-512 register */
+const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024; /**< Bytes of a huge page, the mappings are rounded up to it */
+
+/******************************** Structures ******************************/
+
+/**
+ * @brief Backing of the memory
+ */
+enum HugePages {
+    HUGE_PAGES_NONE,        /**< Normal pages */
+    HUGE_PAGES_TRANSPARENT, /**< Normal pages with madvise, the kernel merges them in huge pages */
+    HUGE_PAGES_EXPLICIT     /**< Pages of the huge page pool (MAP_HUGETLB), transparent if the pool is empty */
+};
+
+/**
+ * @brief Get the backing of a name of the configuration
+ * @param name none, transparent or explicit
+ * @return The backing, normal pages for an unknown name
+ */
+inline HugePages getHugePages(const std::string& name) {
+    return name == "explicit" ? HUGE_PAGES_EXPLICIT : name == "transparent" ? HUGE_PAGES_TRANSPARENT : HUGE_PAGES_NONE;
+}
+
+/**
+ * @brief Allocator of std::vector with the memory aligned to MEMORY_ALIGNMENT. With huge pages the
+ * memory is mapped in multiples of HUGE_PAGE_SIZE, so it is only worth for big buffers
+ * @tparam T Type of the elements
+ */
+template <typename T>
+class AlignedAllocator {
+   public:
+    typedef T value_type;
+    HugePages hugePages; /**< Backing of the memory */
+
+    /**
+     * @brief Constructor
+     * @param hugePages Backing of the memory
+     */
+    AlignedAllocator(HugePages hugePages = HUGE_PAGES_NONE) : hugePages(hugePages) {}
+
+    /**
+     * @brief Constructor of the allocator of another type, needed by the containers
+     * @param other The allocator to copy
+     */
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U>& other) : hugePages(other.hugePages) {}
+
+    /**
+     * @brief Allocate the memory
+     * @param n Number of elements
+     * @return Pointer to the memory, aligned to MEMORY_ALIGNMENT
+     */
+    T* allocate(size_t n) {
+        size_t bytes = this->getBytes(n);
+        if (this->hugePages == HUGE_PAGES_NONE) {
+            void* ptr = aligned_alloc(MEMORY_ALIGNMENT, bytes);
+            if (!ptr) {
+                throw std::bad_alloc();
+            }
+            return (T*)ptr;
+        }
+
+        void* ptr = MAP_FAILED;
+        if (this->hugePages == HUGE_PAGES_EXPLICIT) {
+            ptr = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        }
+        if (ptr == MAP_FAILED) {
+            ptr = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (ptr == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            // Only a hint, the memory is valid with normal pages if the kernel ignores it
+            madvise(ptr, bytes, MADV_HUGEPAGE);
+        }
+        return (T*)ptr;
+    }
+
+    /**
+     * @brief Free the memory
+     * @param ptr Pointer returned by allocate
+     * @param n Number of elements given to allocate
+     */
+    void deallocate(T* ptr, size_t n) {
+        if (this->hugePages == HUGE_PAGES_NONE) {
+            free(ptr);
+        } else {
+            munmap(ptr, this->getBytes(n));
+        }
+    }
+
+    /**
+     * @brief Get the bytes allocated for a number of elements
+     * @param n Number of elements
+     * @return Bytes rounded up to MEMORY_ALIGNMENT, or to HUGE_PAGE_SIZE with huge pages
+     */
+    size_t getBytes(size_t n) const {
+        size_t unit = this->hugePages == HUGE_PAGES_NONE ? MEMORY_ALIGNMENT : HUGE_PAGE_SIZE;
+        return (n * sizeof(T) + unit - 1) / unit * unit;
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const AlignedAllocator<T>& a, const AlignedAllocator<U>& b) {
+    return a.hugePages == b.hugePages;
+}
+
+template <typename T, typename U>
+bool operator!=(const AlignedAllocator<T>& a, const AlignedAllocator<U>& b) {
+    return !(a == b);
+}
+
+/**
+ * @brief Vector of floats aligned to MEMORY_ALIGNMENT
+ */
+typedef std::vector<float, AlignedAllocator<float>> AlignedVector;
+
+/**
+ * @brief Round up a number of floats to fill the aligned blocks, so every row of a padded table
+ * starts aligned and the kernels have no remainder loop
+ * @param n Number of floats
+ * @return The smallest multiple of MEMORY_ALIGNMENT / sizeof(float) not less than n
+ */
+inline unsigned int getPaddedLength(unsigned int n) {
+    const unsigned int width = MEMORY_ALIGNMENT / sizeof(float);
+    return (n + width - 1) / width * width;
+}
+
+#endif
@@ -0,0 +1,105 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file checkpoint.h
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Function declarations of the checkpoints of the hyperparameter search
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+/********************************* Includes *******************************/
+#include <map>
+#include <string>
+#include <vector>
+
+#include "config.h"
+
+/******************************** Constants *******************************/
+const char* const CHECKPOINT_MAGIC = "hpknn-checkpoint"; /**< First word of a checkpoint file */
+const char* const WARNING_CHECKPOINT_MISMATCH = "Warning: Checkpoint file does not match the configuration, it is ignored.";
+const char* const ERROR_CHECKPOINT_WRITE = "Error: Cannot write the checkpoint file.";
+
+/******************************** Structures ******************************/
+
+/**
+ * @brief Class that keeps the accuracies of each number of features already evaluated by the search
+ * and writes them periodically to a file, so a search that dies can resume from the missing work
+ */
+class Checkpoint {
+   private:
+    std::string filename;                                     /**< File of the checkpoint, empty if disabled */
+    std::string fingerprint;                                  /**< Data and parameters of the search that wrote the file */
+    unsigned int nK;                                          /**< Number of values of k evaluated per number of features */
+    unsigned int interval;                                    /**< Chunks completed between two writes */
+    unsigned int pending;                                     /**< Chunks completed since the last write */
+    std::map<unsigned int, std::vector<unsigned int>> done;  /**< Accuracies of each k by number of features */
+
+   public:
+    /**
+     * @brief Constructor, loads the checkpoint file if it exists and matches the search, the same
+     * number of values of k and the same fingerprint of the data and parameters
+     * @param filename File of the checkpoint, empty to keep the results only in memory
+     * @param nK Number of values of k evaluated per number of features
+     * @param config The configuration of the search, with the interval of the writes
+     */
+    Checkpoint(const std::string& filename, unsigned int nK, const Config& config);
+
+    /**
+     * @brief Check if a number of features has been already evaluated
+     * @param nFeatures The number of features
+     * @return true if its accuracies are known
+     */
+    bool isDone(unsigned int nFeatures) const;
+
+    /**
+     * @brief Check if every number of features of a chunk has been already evaluated
+     * @param ptrFeatures The chunk covers from ptrFeatures + 1 to ptrFeatures + chunkSize
+     * @param chunkSize The number of features of the chunk
+     * @return true if the whole chunk is known
+     */
+    bool isChunkDone(unsigned int ptrFeatures, unsigned int chunkSize) const;
+
+    /**
+     * @brief Store the accuracies of a number of features
+     * @param nFeatures The number of features
+     * @param accuracies Number of correct predictions for each k
+     */
+    void add(unsigned int nFeatures, const std::vector<unsigned int>& accuracies);
+
+    /**
+     * @brief Mark a chunk as completed and write the file if the interval has been reached
+     */
+    void chunkDone();
+
+    /**
+     * @brief Write the file atomically, first to a temporary file that replaces the old one, and
+     * sync the directory so the rename survives a crash
+     */
+    void save();
+
+    /**
+     * @brief Remove the file, called when the search has finished
+     */
+    void remove();
+
+    /**
+     * @brief Get the best hyperparameters among the accuracies stored
+     * @param minValueK The value of k of the first accuracy
+     * @return Vector with the best K, best features, and accuracy
+     */
+    std::vector<unsigned int> getBest(unsigned int minValueK) const;
+};
+
+#endif
@@ -0,0 +1,95 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file condensation.h
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Function declarations of the reduction of the training data (Wilson editing and Hart condensing)
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+#ifndef CONDENSATION_H
+#define CONDENSATION_H
+
+/********************************* Includes *******************************/
+#include <vector>
+
+#include "config.h"
+
+/******************************** Constants *******************************/
+const unsigned int CONDENSATION_BLOCK = 64; /**< Tuples of the Hart condensing classified in parallel against the same subset */
+
+/********************************* Methods ********************************/
+/**
+ * @brief Wilson editing, keep the training tuples whose class is the most frequent among their k
+ * nearest other tuples, so the noisy tuples and the ones at the border are removed
+ * @param k The number of neighbors of each tuple
+ * @param dataTraining The training data
+ * @param labelsTraining The labels of the training data
+ * @param distanceFunction The distance function to use
+ * @param nFeatures The number of features to use in the distance function
+ * @param config The configuration of the algorithm
+ * @return Positions of the training tuples kept, in order
+ */
+std::vector<unsigned int> wilsonEditing(int k,
+                                        std::vector<float>& dataTraining,
+                                        std::vector<unsigned int>& labelsTraining,
+                                        float (*distanceFunction)(std::vector<float>&,
+                                                                  std::vector<float>&,
+                                                                  unsigned int,
+                                                                  unsigned int,
+                                                                  unsigned int),
+                                        unsigned int nFeatures,
+                                        const Config& config);
+
+/**
+ * @brief Hart condensing, get a subset of the training tuples that classifies all of them right
+ * with the nearest neighbor. The tuples are classified in blocks of CONDENSATION_BLOCK in
+ * parallel, and the ones misclassified by the subset are added to it, until a pass adds none
+ * @param dataTraining The training data
+ * @param labelsTraining The labels of the training data
+ * @param distanceFunction The distance function to use
+ * @param nFeatures The number of features to use in the distance function
+ * @param config The configuration of the algorithm
+ * @param candidates Positions of the training tuples to condense, in order
+ * @return Positions of the training tuples of the subset, in order
+ */
+std::vector<unsigned int> hartCondensing(std::vector<float>& dataTraining,
+                                         std::vector<unsigned int>& labelsTraining,
+                                         float (*distanceFunction)(std::vector<float>&,
+                                                                   std::vector<float>&,
+                                                                   unsigned int,
+                                                                   unsigned int,
+                                                                   unsigned int),
+                                         unsigned int nFeatures,
+                                         const Config& config,
+                                         const std::vector<unsigned int>& candidates);
+
+/**
+ * @brief Reduce the training data with the method of condensation, after it the data only has
+ * the tuples kept, in the same order
+ * @param dataTraining The training data, it is reduced
+ * @param labelsTraining The labels of the training data, they are reduced
+ * @param distanceFunction The distance function to use
+ * @param nFeatures The number of features to use in the distance function
+ * @param config The configuration of the algorithm, with condensation and condensationK
+ */
+void condenseTrainingData(std::vector<float>& dataTraining,
+                          std::vector<unsigned int>& labelsTraining,
+                          float (*distanceFunction)(std::vector<float>&,
+                                                    std::vector<float>&,
+                                                    unsigned int,
+                                                    unsigned int,
+                                                    unsigned int),
+                          unsigned int nFeatures,
+                          const Config& config);
+
+#endif
@@ -24,9 +24,19 @@
 
 /******************************** Constants *******************************/
 const char* const ERROR_PARSE_ARGUMENTS = "Error: Missing required value of the argument or nothing to parse, please use -h for more information.";
-const char* const ERROR_MODE = "Error: -mode must be hetero or homo";
+const char* const ERROR_MODE = "Error: -mode must be hetero, homo or serve";
 const char* const ERROR_NPROCESS_HOMO = "Error: Number of data ntuple * nfeatures is not divisible by the number of processors";
 const char* const ERROR_NPROCESS_HETERO = "Error: Mode hetero must have two process or more";
+const char* const ERROR_MPI_THREAD = "Error: The MPI library does not support MPI_THREAD_SERIALIZED";
+const char* const ERROR_NO_SLAVES = "Error: Every slave was excluded before the search finished, the checkpoint keeps the chunks done";
+const char* const WARNING_LOST_SLAVES = "Warning: Some excluded slaves never answered, the processes are aborted instead of finalized";
+const char* const ERROR_KNN_INDEX = "Error: knnIndex must be brute, auto, kdtree, vptree, laesa, hnsw, ivfpq, lsh, int8 or hamming";
+const char* const ERROR_LSH_FAMILY = "Error: lshFamily must be l2, l1 or cosine";
+const char* const ERROR_CONDENSATION = "Error: condensation must be none, wilson, hart or wilson-hart";
+const char* const ERROR_DATA_LAYOUT = "Error: dataLayout must be row or column";
+const char* const ERROR_HUGE_PAGES = "Error: hugePages must be none, transparent or explicit";
+const char* const ERROR_NUMA = "Error: numa must be none, replicate or interleave";
+const char* const ERROR_DATA_PRECISION = "Error: dataPrecision must be fp32, or fp16 or bf16 with the column dataLayout";
 const char* const ERROR_CHUNKSIZE_HETERO = "Error: Number of data ntuple * nfeatures is not divisible by the chunsize in config.json";
 
 /******************************** Structures ******************************/
@@ -40,7 +50,7 @@ typedef struct Config {
     std::string dbDataTraining;   /**< Filename of the dataset to train */
     std::string dbLabelsTraining; /**< Filename of the dataset labels to train */
     std::string MRMR;             /**< Filename of the MRMR file */
-    std::string mode;             /**< Mode of the program, hetero or homo platforms */
+    std::string mode;             /**< Mode of the program, hetero or homo platforms or serve */
     long nTuples;                 /**< Number of tuples of the dataset */
     long nFeatures;               /**< Number of features of the dataset */
     long TAM;                     /**< Number of tuples * number of features */
@@ -51,7 +61,51 @@ typedef struct Config {
     long maxFeatures;             /**< Maximum number of features to use */
     unsigned int chunkSize;       /**< Size of the chunk to send to the slaves */
     bool savingEnergy;            /**< Flag to save the energy of the program */
+    std::string energyApiHost;    /**< Host of the energy price API */
+    unsigned int energyApiPort;   /**< Port of the energy price API */
+    std::string energyApiPath;    /**< Path of the current energy price in the API */
+    std::string energyApiCaFile;  /**< File with the certificates that verify the API, empty for the ones of the system */
     bool stridedHomo;             /**< Flag to set strided or no strided version for homo mode */
+    std::string dataLayout;       /**< Layout of the search: row computes each number of features again, column adds one feature to the distances of the previous one */
+    std::string dataPrecision;    /**< Precision of the data of the column layout: fp32, fp16 or bf16 */
+    bool validatePrecision;       /**< Flag to compare the accuracies of dataPrecision with fp32 in the homo search */
+    std::string numa;             /**< Placement of the training data in the NUMA nodes: none, replicate or interleave */
+    std::string hugePages;        /**< Huge pages of the column layout: none, transparent (madvise) or explicit (MAP_HUGETLB) */
+    unsigned int prefetchDistance; /**< Training tuples ahead that the row scan prefetches, 0 to disable it */
+    bool measureEnergy;           /**< Flag to measure the energy of each phase with RAPL counters */
+    unsigned int nRuns;           /**< Number of times the search is repeated, 0 to repeat it forever */
+    std::string checkpointFile;   /**< File where the search saves its progress, empty to disable it */
+    unsigned int checkpointInterval; /**< Chunks of features completed between two checkpoints */
+    float stragglerFactor;        /**< Chunks running longer than this times the mean are sent again, 0 to disable it */
+    float slaveTimeout;           /**< Seconds without answer after which a slave is excluded, 0 to disable it */
+    std::string serveSocket;      /**< Unix domain socket where the serve mode listens */
+    unsigned int serveK;          /**< Number of neighbors used by the serve mode */
+    unsigned int serveNFeatures;  /**< Number of features, sorted by MRMR, used by the serve mode */
+    unsigned int serveBatchSize;  /**< Maximum number of feature vectors classified together */
+    unsigned int serveBatchWaitUs; /**< Microseconds that a batch waits for more requests */
+    unsigned int serveMaxFrameVectors; /**< Maximum number of feature vectors accepted in one frame of a client */
+    std::string knnIndex;         /**< Index of the nearest neighbors: brute, kdtree, vptree, laesa, hnsw, ivfpq, lsh, int8, hamming or auto to choose by the number of features */
+    unsigned int kdTreeMaxFeatures; /**< Maximum number of features for which auto uses the kd-tree */
+    unsigned int laesaPivots;     /**< Pivots of the LAESA index */
+    unsigned int hnswM;           /**< Links of each tuple in the upper levels of the HNSW graph */
+    unsigned int hnswEfConstruction; /**< Candidates explored to link a tuple when the HNSW graph is built */
+    unsigned int hnswEfSearch;    /**< Candidates explored by a query in the HNSW graph, more is slower with more recall */
+    unsigned int ivfLists;        /**< Coarse centroids of the IVF-PQ index, 0 for the square root of the number of tuples */
+    unsigned int ivfProbe;        /**< Lists of the IVF-PQ index scanned by a query */
+    unsigned int pqSubspaces;     /**< Groups of features of the IVF-PQ index, each one is encoded in a byte */
+    unsigned int ivfRerank;       /**< Candidates of the IVF-PQ index compared with the training data, 0 to disable it */
+    std::string lshFamily;        /**< Hash family of the LSH index: l2, l1 or cosine */
+    unsigned int lshTables;       /**< Hash tables of the LSH index */
+    unsigned int lshHashes;       /**< Projections joined in the key of each LSH table */
+    float lshWidth;               /**< Width of the buckets of the l2 and l1 projections */
+    unsigned int lshCandidates;   /**< Maximum candidates of a query in the LSH index, 0 for no limit */
+    unsigned int int8Rerank;      /**< Candidates of the int8 index compared with the training data, 0 to disable it */
+    unsigned int hammingCandidates; /**< Candidates of the hamming index compared with the training data */
+    std::string condensation;     /**< Reduction of the training data: none, wilson, hart or wilson-hart */
+    unsigned int condensationK;   /**< Neighbors of the Wilson editing */
+    bool reportRecall;            /**< Flag to compare the index with the full scan after the final score */
+    std::string serveShm;         /**< Name of the shared memory ring for clients in the same host, empty to disable it */
+    unsigned int serveShmSlots;   /**< Number of vectors of the shared memory ring, a power of two */
 
     /********************************* Methods ********************************/
     /**
@@ -0,0 +1,152 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file dataset.h
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Function declarations of the Dataset class, a table of tuples and features stored by rows or by columns
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+#ifndef DATASET_H
+#define DATASET_H
+
+/********************************* Includes *******************************/
+#include <stddef.h>
+
+#include <vector>
+
+#include "alignedAllocator.h"
+#include "halfFloat.h"
+
+/******************************** Structures ******************************/
+
+/**
+ * @brief Layout of the values of a Dataset
+ */
+enum DataLayout {
+    ROW_MAJOR,   /**< The features of a tuple are together, as the data read from the files */
+    COLUMN_MAJOR /**< The values of a feature for all the tuples are together */
+};
+
+/**
+ * @brief Table of nTuples tuples with nFeatures features. The row major layout is the one of
+ * dataTraining and dataTest, the column major one reads a feature of all the tuples with unit stride.
+ * Each row or column starts aligned to MEMORY_ALIGNMENT and is padded with zeros to getStride values.
+ * The values can be stored in FP16 or BF16, which halves the memory read by a scan
+ */
+class Dataset {
+   private:
+    AlignedVector data;                                         /**< Values of the table in its layout, in FP32 */
+    std::vector<uint16_t, AlignedAllocator<uint16_t>> halfData; /**< Values of the table in its layout, in FP16 or BF16 */
+    unsigned int nTuples;                                       /**< Number of tuples */
+    unsigned int nFeatures;                                     /**< Number of features of each tuple */
+    DataLayout layout;                                          /**< Layout of data */
+    DataPrecision precision;                                    /**< Precision of the values */
+    unsigned int stride;                                        /**< Values of each row or column with the padding */
+
+   public:
+    /**
+     * @brief Constructor, copies the first features of each tuple of a row major vector
+     * @param rows The data, one tuple after the other
+     * @param stride The number of features of each tuple of rows
+     * @param nFeatures The number of features copied, the first ones of each tuple
+     * @param layout The layout of the dataset
+     * @param precision The precision of the values, rounded to the nearest
+     * @param hugePages Backing of the memory
+     */
+    Dataset(const std::vector<float>& rows,
+            unsigned int stride,
+            unsigned int nFeatures,
+            DataLayout layout,
+            DataPrecision precision = PRECISION_FP32,
+            HugePages hugePages = HUGE_PAGES_NONE);
+
+    /**
+     * @brief Get a value
+     * @param tuple The position of the tuple
+     * @param feature The position of the feature
+     * @return The value of the feature of the tuple, widened to float
+     */
+    float get(unsigned int tuple, unsigned int feature) const {
+        size_t position = this->layout == ROW_MAJOR ? (size_t)tuple * this->stride + feature : (size_t)feature * this->stride + tuple;
+        return this->precision == PRECISION_FP32 ? this->data[position] : widen(this->halfData[position], this->precision);
+    }
+
+    /**
+     * @brief Get the values of a feature in FP16 or BF16, only in the column major layout
+     * @param feature The position of the feature
+     * @return Pointer to the nTuples values of the feature and the padding
+     */
+    const uint16_t* getHalfColumn(unsigned int feature) const {
+        return &this->halfData[(size_t)feature * this->stride];
+    }
+
+    /**
+     * @brief Get the values of a tuple, only in the row major layout and FP32
+     * @param tuple The position of the tuple
+     * @return Pointer to the nFeatures values of the tuple and the padding, aligned
+     */
+    const float* getRow(unsigned int tuple) const {
+        return &this->data[(size_t)tuple * this->stride];
+    }
+
+    /**
+     * @brief Get the values of a feature, only in the column major layout and FP32
+     * @param feature The position of the feature
+     * @return Pointer to the nTuples values of the feature and the padding, aligned
+     */
+    const float* getColumn(unsigned int feature) const {
+        return &this->data[(size_t)feature * this->stride];
+    }
+
+    /**
+     * @brief Get the number of tuples
+     * @return The number of tuples
+     */
+    unsigned int getNTuples() const {
+        return this->nTuples;
+    }
+
+    /**
+     * @brief Get the number of features
+     * @return The number of features of each tuple
+     */
+    unsigned int getNFeatures() const {
+        return this->nFeatures;
+    }
+
+    /**
+     * @brief Get the values of each row or column, the ones read by a kernel without remainder loop
+     * @return nFeatures or nTuples, rounded up by getPaddedLength
+     */
+    unsigned int getStride() const {
+        return this->stride;
+    }
+
+    /**
+     * @brief Get the precision
+     * @return The precision of the values
+     */
+    DataPrecision getPrecision() const {
+        return this->precision;
+    }
+
+    /**
+     * @brief Get the layout
+     * @return The layout of the values
+     */
+    DataLayout getLayout() const {
+        return this->layout;
+    }
+};
+
+#endif
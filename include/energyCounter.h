@@ -0,0 +1,115 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file energyCounter.h
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Function declarations of the RAPL energy counters
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+#ifndef ENERGY_COUNTER_H
+#define ENERGY_COUNTER_H
+
+/********************************* Includes *******************************/
+#include <ostream>
+#include <string>
+#include <vector>
+
+/******************************** Constants *******************************/
+const char* const POWERCAP_PATH = "/sys/class/powercap";
+const char* const WARNING_RAPL_UNAVAILABLE = "Warning: RAPL counters are not available, only times will be reported.";
+
+/**
+ * @brief Phases of main() to which the energy is attributed
+ */
+enum Phase {
+    PHASE_LOAD,      /**< Read the databases from files */
+    PHASE_NORMALIZE, /**< Normalize the data */
+    PHASE_MRMR,      /**< Sort the features by MRMR */
+    PHASE_SEARCH,    /**< Search of the best hyperparameters */
+    PHASE_SCORE,     /**< Score of the best hyperparameters */
+    N_PHASES         /**< Number of phases */
+};
+
+const char* const PHASE_NAMES[N_PHASES] = {"load", "normalize", "MRMR sort", "hyperparameter search", "scoring"};
+
+/******************************** Structures ******************************/
+
+/**
+ * @brief Class that reads the RAPL counters exposed by the powercap interface and attributes
+ * the package and DRAM joules consumed to each phase of the program
+ */
+class EnergyCounter {
+   private:
+    /**
+     * @brief RAPL domain (package or DRAM) of the powercap interface
+     */
+    typedef struct Domain {
+        std::string path;            /**< Path of the energy_uj file */
+        bool isDram;                 /**< Flag to know if the domain is DRAM or package */
+        unsigned long long maxRange; /**< Value where the counter wraps around */
+    } Domain;
+
+    std::vector<Domain> domains;                  /**< RAPL domains found in the node */
+    std::vector<unsigned long long> startCounter; /**< Value of each counter when the phase started */
+    double startTime;                             /**< Time when the phase started */
+    int currentPhase;                             /**< Phase being measured, -1 if none */
+    bool nodeLeader;                              /**< Flag to know if this process reads the counters of its node */
+    double seconds[N_PHASES];                     /**< Seconds spent in each phase */
+    double packageJoules[N_PHASES];               /**< Package joules consumed in each phase */
+    double dramJoules[N_PHASES];                  /**< DRAM joules consumed in each phase */
+
+    /**
+     * @brief Look for the package and DRAM domains in the powercap interface
+     */
+    void discoverDomains();
+
+    /**
+     * @brief Read the current value of the counters of every domain
+     * @return std::vector<unsigned long long> with the microjoules of each domain
+     */
+    std::vector<unsigned long long> readCounters() const;
+
+   public:
+    /**
+     * @brief Constructor, discovers the RAPL domains. Only one process per node reads the
+     * counters so the energy of the node is not counted twice
+     */
+    EnergyCounter();
+
+    /**
+     * @brief Check if RAPL counters have been found
+     * @return true if the counters can be read, false otherwise
+     */
+    bool isAvailable() const;
+
+    /**
+     * @brief Start the measurement of a phase
+     * @param phase The phase to measure
+     */
+    void start(Phase phase);
+
+    /**
+     * @brief Stop the measurement of the current phase and accumulate its time and energy
+     */
+    void stop();
+
+    /**
+     * @brief Aggregate the measurements of all the processes in the root and print the report.
+     * It is a collective operation, so every process must call it
+     * @param os The output stream of the root process
+     * @param nQueries Number of queries classified in the scoring phase, to get the energy per query
+     */
+    void report(std::ostream& os, unsigned long nQueries);
+};
+
+#endif
@@ -20,86 +20,34 @@
 #define ENERGY_SAVING_H
 
 /********************************* Includes *******************************/
-#include <arpa/inet.h>
-#include <netdb.h>
-#include <netinet/in.h>
-#include <openssl/err.h>
-#include <openssl/ssl.h>
-#include <stdio.h>
-#include <sys/socket.h>
-#include <unistd.h>
+#include <mpi.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <ctime>
+#include <limits>
+#include <mutex>
 #include <string>
 
+#include "config.h"
+#include "httpClient.h"
+
 /******************************** Constants *******************************/
+const int ENERGY_OWNER_RANK = 0;                              /**< Rank that fetches the price and decides for the cluster */
+const int ENERGY_PAUSE_MARGIN = 5;                            /**< Seconds paused after the next fetch of the owner */
+const int TAG_ENERGY_DECISION = 0;                            /**< Tag of the decisions in the energy communicator */
+const unsigned int ENERGY_LAST_EPOCH = std::numeric_limits<unsigned int>::max(); /**< Epoch of the last decision, sent when the search ends */
 
 /******************************** Structures ******************************/
 
 /**
- * @brief Class manage the energy saving, realizate the connection with the server and get the data
+ * @brief Run/pause decision taken by the owner of the price feed and broadcast to every process
  */
-class EnergyAwareClientAPI {
-   private:
-    int sock;                  /**< Socket descriptor */
-    SSL *ssl;                  /**< SSL descriptor */
-    char *host;                /**< Host name */
-    int port;                  /**< Port */
-    struct sockaddr_in server; /**< Server address */
-
-    /**
-     * @brief Open Socket
-     * @return 0 if success, -1 if error
-     * @return int
-     */
-    int openSocket();
-
-    /**
-     * @brief Connect to the server
-     * @return 0 if success, -1 if error
-     * @return int
-     */
-    int connectToServer();
-
-    /**
-     * @brief Init the SSL
-     */
-    void initSSL();
-
-    /**
-     * @brief Convert host name to IP
-     * @param host Host name
-     * @return char*
-     */
-    char *hostToIp(const char *host);
-
-   public:
-    /**
-     * @brief Constructor
-     * @param host Host name
-     * @param port Port
-     */
-    EnergyAwareClientAPI(const char *host, int port);
-
-    /**
-     * @brief Send package
-     *
-     * @param buffer Buffer to send
-     * @return int
-     */
-    int sendPackage(const char *buffer);
-
-    /**
-     * @brief Receive package
-     *
-     * @return string
-     */
-    std::string recvPackage();
-
-    /**
-     * @brief Close the socket
-     */
-    void closeConnection();
-};
+typedef struct EnergyDecision {
+    unsigned int epoch;   /**< Number of the fetch that produced the decision, 0 if there is no data yet */
+    unsigned int pause;   /**< 1 if the processes must pause, 0 if they can run */
+    unsigned int seconds; /**< Seconds to pause, until the next fetch of the owner */
+} EnergyDecision;
 
 /**
  * @brief Struct of Energy that permit set the energy saving for the program from json response
@@ -113,15 +61,26 @@ typedef struct Energy {
     std::string market;           /**< Market of the energy saving */
     float price;                  /**< Price of the energy saving */
     std::string units;            /**< Units of the energy saving */
-    EnergyAwareClientAPI *client; /**< Client to connect to the server */
+    HttpClient *client;           /**< Client to connect to the server, kept alive between fetches */
+    std::string path;             /**< Path of the current energy price in the server */
+    std::atomic<unsigned int> epoch; /**< Number of fetches done by the owner */
+    std::time_t nextFetch;           /**< Time of the next fetch of the owner */
+    std::mutex mutex;                /**< Mutex between the thread that fetches and the one that decides */
+    std::condition_variable wakeUp;  /**< Wakes up the thread that fetches when the work ends */
+    std::atomic<bool> stopped;       /**< Flag to stop the thread that fetches */
+    unsigned int appliedEpoch;       /**< Last decision applied by this process */
+    unsigned int publishedEpoch;     /**< Last decision sent by the owner in hetero mode */
+    MPI_Comm comm;                   /**< Communicator dedicated to the decisions */
+    int rank;                        /**< Rank of this process */
 
     /********************************* Methods ********************************/
 
     /**
      * @brief Construct a new Energy object
+     * @param config The configuration with the host, port, path and CA file of the energy price API
      * @return An object containing all configuration parameters
      */
-    Energy();
+    Energy(const Config &config);
 
     /**
      * @brief Destroy the Energy object
@@ -130,31 +89,66 @@ typedef struct Energy {
 
     /**
      * @brief fetch to API the energy saving and set the values of the struct
+     * @return true if the values have been updated, false if the request failed
      */
-    void fetchEnergyPriceNow();
+    bool fetchEnergyPriceNow();
 
     /**
-     * @brief Function that reads the vals and determine if needs to sleep
+     * @brief Check each hour doing fetch to API the energy saving and set the values of the struct
+     * thread 0 of the owner check every hour if the energy saving is cheap, and sleep thread
      */
-    void checkSleep();
+    void checkEnergyPrice();
 
     /**
-     * @brief Check each hour doing fetch to API the energy saving and set the values of the struct
-     * thread 0 check every hour if the energy saving is cheap, and sleep thread
+     * @brief sleep thread until the next hour, or until the work ends
      */
-    void checkEnergyPrice();
+    void sleepThread();
 
     /**
-     * @brief sleep thread one hour
-     * @param isSlave if is slave sleep 5 seconds more
+     * @brief Stop the thread that fetches, it returns from checkEnergyPrice without waiting for the next hour
      */
-    void sleepThread(bool isSlave = false);
+    void stop();
 
     /**
-     * @brief thread slace wait until master do fetch to API the energy saving and set the values of the struct
+     * @brief thread of the owner wait until it does the first fetch to API
      */
     void waitUntilInitializeData();
 
+    /**
+     * @brief Build the decision of the owner from the last values fetched
+     * @return EnergyDecision with the current epoch
+     */
+    EnergyDecision getDecision();
+
+    /**
+     * @brief Pause the process if the decision is new and says so
+     * @param decision The decision received from the owner
+     */
+    void applyDecision(const EnergyDecision &decision);
+
+    /**
+     * @brief Collective of the homo mode, the owner broadcasts its decision and every process
+     * applies it at the same chunk boundary
+     */
+    void syncDecision();
+
+    /**
+     * @brief Used by the master in hetero mode, send the decision to the slaves if it has changed
+     */
+    void publishDecision();
+
+    /**
+     * @brief Used by the slaves in hetero mode before each chunk, receive the decisions sent by
+     * the owner and apply the newest one. Blocks until the first decision arrives
+     */
+    void checkSleep();
+
+    /**
+     * @brief Used at the end of the hetero search, the owner sends the last decision and the slaves
+     * receive the decisions until it, so a slave waiting for the first decision is released
+     */
+    void endDecisions();
+
     /**
      * @brief Overload of the operator << to print the Energy object
      * @param os The output stream
@@ -0,0 +1,111 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file featureSweep.h
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Function declarations of the incremental sweep over the number of features
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+#ifndef FEATURESWEEP_H
+#define FEATURESWEEP_H
+
+/********************************* Includes *******************************/
+#include <vector>
+
+#include "config.h"
+#include "dataset.h"
+
+/******************************** Structures ******************************/
+
+/**
+ * @brief Partial sums of the distances between every test tuple and every training tuple, for
+ * the first features sorted by MRMR. Going from f to f + 1 features only adds the term of one
+ * feature, read from the column major copies of the data with unit stride, instead of computing
+ * the f + 1 terms again. The sums are added in the same order as euclideanDistance and
+ * manhattanDistance, so in FP32 the accuracies are the same as the ones of getAccuracies. The
+ * copies can be stored in FP16 or BF16, widened to FP32 in blocks of WIDEN_BLOCK, and the sums are
+ * always FP32. It keeps nTuples test x nTuples training floats, with the huge pages of hugePages
+ */
+class FeatureSweep {
+   private:
+    Dataset training;                          /**< Training data, column major */
+    Dataset test;                              /**< Test data, column major */
+    std::vector<unsigned int>& labelsTraining; /**< Labels of the training data */
+    bool squared;                              /**< If the terms are squared (Euclidean) or absolute (Manhattan) */
+    AlignedVector sums;                        /**< Partial sums, the ones of a test tuple together and padded like a column */
+    unsigned int nFeatures;                    /**< Features added to the sums */
+
+    /**
+     * @brief Add the terms of a feature to the sums of a test tuple
+     * @param sums The sums of the test tuple
+     * @param values The values of the feature for the training tuples
+     * @param value The value of the feature for the test tuple
+     * @param n The number of values
+     */
+    void addTerms(float* sums, const float* values, float value, unsigned int n) const;
+
+   public:
+    /**
+     * @brief Check if a distance function can be computed by the sweep
+     * @param distanceFunction The distance function
+     * @return true for euclideanDistance and manhattanDistance
+     */
+    static bool supports(float (*distanceFunction)(std::vector<float>&,
+                                                   std::vector<float>&,
+                                                   unsigned int,
+                                                   unsigned int,
+                                                   unsigned int));
+
+    /**
+     * @brief Constructor, copies the data in column major layout, with no features added
+     * @param dataTraining The training data
+     * @param dataTest The test data
+     * @param labelsTraining The labels of the training data, they must outlive the sweep
+     * @param distanceFunction The distance function, it must be supported
+     * @param maxFeatures The maximum number of features that will be added
+     * @param config The configuration of the algorithm
+     * @param precision The precision of the copies of the data
+     */
+    FeatureSweep(std::vector<float>& dataTraining,
+                 std::vector<float>& dataTest,
+                 std::vector<unsigned int>& labelsTraining,
+                 float (*distanceFunction)(std::vector<float>&,
+                                           std::vector<float>&,
+                                           unsigned int,
+                                           unsigned int,
+                                           unsigned int),
+                 unsigned int maxFeatures,
+                 const Config& config,
+                 DataPrecision precision);
+
+    /**
+     * @brief Add the features until the sums use the first nFeatures
+     * @param nFeatures The number of features, not less than the ones added and not more than maxFeatures
+     */
+    void addFeatures(unsigned int nFeatures);
+
+    /**
+     * @brief Get the number of correct predictions of each k using a number of features
+     * @param nFeatures The number of features, not less than the ones added and not more than maxFeatures
+     * @param minValueK The minimum value of K with starts
+     * @param maxValueK The maximum value of K with ends
+     * @param labelsTest The labels of the test data
+     * @return Vector with the correct predictions of each k, from minValueK to maxValueK
+     */
+    std::vector<unsigned int> getAccuracies(unsigned int nFeatures,
+                                            unsigned short minValueK,
+                                            unsigned short maxValueK,
+                                            std::vector<unsigned int>& labelsTest);
+};
+
+#endif
@@ -0,0 +1,159 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file halfFloat.h
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Conversions between float and the 16 bits formats FP16 (IEEE half) and BF16 (bfloat16)
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+#ifndef HALFFLOAT_H
+#define HALFFLOAT_H
+
+/********************************* Includes *******************************/
+#include <stdint.h>
+#include <string.h>
+
+#include <string>
+
+/******************************** Constants *******************************/
+const unsigned int WIDEN_BLOCK = 16; /**< Values widened together by the functions of getWidenBlock, a multiple of the SIMD width */
+
+/******************************** Structures ******************************/
+
+/**
+ * @brief Precision of the values stored
+ */
+enum DataPrecision {
+    PRECISION_FP32, /**< float */
+    PRECISION_FP16, /**< IEEE half, 10 bits of mantissa */
+    PRECISION_BF16  /**< bfloat16, the 16 upper bits of a float, 7 bits of mantissa */
+};
+
+/********************************* Methods ********************************/
+/**
+ * @brief Get the precision of a name of the configuration
+ * @param name fp32, fp16 or bf16
+ * @return The precision, fp32 for an unknown name
+ */
+inline DataPrecision getDataPrecision(const std::string& name) {
+    return name == "fp16" ? PRECISION_FP16 : name == "bf16" ? PRECISION_BF16 : PRECISION_FP32;
+}
+
+/**
+ * @brief Round a float to the nearest FP16, ties to even
+ * @param value The float
+ * @return The bits of the FP16
+ */
+inline uint16_t floatToHalf(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint32_t sign = bits & 0x80000000;
+    bits ^= sign;
+
+    uint16_t half;
+    if (bits >= (127 + 16) << 23) {
+        // Too big for FP16, infinity or NaN
+        half = bits > 255u << 23 ? 0x7e00 : 0x7c00;
+    } else if (bits < 113 << 23) {
+        // Subnormal in FP16, the addition of the float rounds the mantissa
+        uint32_t magicBits = ((127 - 15) + (23 - 10) + 1) << 23;
+        float magic, sum;
+        memcpy(&magic, &magicBits, sizeof(magic));
+        memcpy(&sum, &bits, sizeof(sum));
+        sum += magic;
+        memcpy(&bits, &sum, sizeof(bits));
+        half = bits - magicBits;
+    } else {
+        uint32_t odd = (bits >> 13) & 1;
+        bits += ((uint32_t)(15 - 127) << 23) + 0xfff + odd;
+        half = bits >> 13;
+    }
+    return half | (sign >> 16);
+}
+
+/**
+ * @brief Widen a FP16 to float, exact
+ * @param half The bits of the FP16
+ * @return The float
+ */
+inline float halfToFloat(uint16_t half) {
+    // The exponent is rebased by a multiplication, which also normalizes the subnormals
+    uint32_t magicBits = (254 - 15) << 23, bits = (uint32_t)(half & 0x7fff) << 13;
+    float magic, value;
+    memcpy(&magic, &magicBits, sizeof(magic));
+    memcpy(&value, &bits, sizeof(value));
+    value *= magic;
+    memcpy(&bits, &value, sizeof(bits));
+    if (bits >= (127 + 16) << 23) {
+        bits |= 255 << 23;
+    }
+    bits |= (uint32_t)(half & 0x8000) << 16;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief Round a float to the nearest BF16, ties to even
+ * @param value The float
+ * @return The bits of the BF16
+ */
+inline uint16_t floatToBFloat16(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    if ((bits & 0x7fffffff) > 0x7f800000) {
+        return (bits >> 16) | 0x40;
+    }
+    return (bits + 0x7fff + ((bits >> 16) & 1)) >> 16;
+}
+
+/**
+ * @brief Widen a BF16 to float, exact
+ * @param bfloat16 The bits of the BF16
+ * @return The float
+ */
+inline float bfloat16ToFloat(uint16_t bfloat16) {
+    uint32_t bits = (uint32_t)bfloat16 << 16;
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief Round a float to a precision
+ * @param value The float
+ * @param precision The precision, FP16 or BF16
+ * @return The bits of the value in the precision
+ */
+inline uint16_t narrow(float value, DataPrecision precision) {
+    return precision == PRECISION_FP16 ? floatToHalf(value) : floatToBFloat16(value);
+}
+
+/**
+ * @brief Widen a value to float
+ * @param value The bits of the value
+ * @param precision The precision of the value, FP16 or BF16
+ * @return The float
+ */
+inline float widen(uint16_t value, DataPrecision precision) {
+    return precision == PRECISION_FP16 ? halfToFloat(value) : bfloat16ToFloat(value);
+}
+
+/**
+ * @brief Get the function that widens WIDEN_BLOCK values to float, the best for the CPU: F16C for
+ * FP16 and AVX-512 BF16 for BF16, or the exact conversions of this file one by one
+ * @param precision The precision of the values, FP16 or BF16
+ * @return The function, that takes the bits of the values and where the floats are stored
+ */
+void (*getWidenBlock(DataPrecision precision))(const uint16_t*, float*);
+
+#endif
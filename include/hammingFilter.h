@@ -0,0 +1,89 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file hammingFilter.h
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Function declarations of the prefilter of the training data by the Hamming distance of binary codes
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+#ifndef HAMMINGFILTER_H
+#define HAMMINGFILTER_H
+
+/********************************* Includes *******************************/
+#include <stdint.h>
+
+#include <vector>
+
+#include "alignedAllocator.h"
+#include "neighborIndex.h"
+
+/******************************** Constants *******************************/
+const unsigned int HAMMING_WORD_BITS = 64;                                /**< Features packed in each word of a code */
+const unsigned int HAMMING_BLOCK_WORDS = MEMORY_ALIGNMENT / sizeof(uint64_t); /**< Words of a code are padded to a multiple of it */
+
+/******************************** Structures ******************************/
+
+/**
+ * @brief Approximate index that keeps one bit for each feature of the training data, set when the
+ * value is over the median of the feature, packed in words of 64 bits. A query is binarized with
+ * the same medians and the training tuples are ranked by the Hamming distance to it, counted with
+ * popcnt or AVX-512 VPOPCNTDQ. The hammingCandidates nearest are compared with the training data
+ * using the distance function, so the scan reads one bit of each feature instead of a float
+ */
+class HammingFilter : public NeighborIndex {
+   private:
+    std::vector<float>& dataTraining;                         /**< Training data, read to re-rank */
+    float (*distanceFunction)(std::vector<float>&,
+                              std::vector<float>&,
+                              unsigned int,
+                              unsigned int,
+                              unsigned int);                /**< Distance function used to re-rank */
+    unsigned int nFeatures;                                   /**< Number of features of the tuples */
+    unsigned int stride;                                      /**< Features of each tuple of the training data */
+    unsigned int nWords;                                      /**< Words of each code, padded with zeros to HAMMING_BLOCK_WORDS */
+    unsigned int nCandidates;                                 /**< Candidates re-ranked with the distance function */
+    std::vector<float> medians;                               /**< Median of each feature in the training data */
+    std::vector<uint64_t, AlignedAllocator<uint64_t>> codes;  /**< Codes of the training data, one after the other */
+    uint32_t (*kernel)(const uint64_t*, const uint64_t*, unsigned int); /**< Hamming distance between two codes, the best for the CPU */
+
+    /**
+     * @brief Binarize a tuple
+     * @param data The data of the tuple
+     * @param ptrData The position of the first feature of the tuple
+     * @param code Where the nWords words of the code are stored, the padding must be zero
+     */
+    void binarize(const std::vector<float>& data, unsigned int ptrData, uint64_t* code) const;
+
+   public:
+    /**
+     * @brief Compute the medians and binarize the training data
+     * @param dataTraining The training data, it must outlive the index
+     * @param labelsTraining The labels of the training data
+     * @param distanceFunction The distance function to use to re-rank
+     * @param nFeatures The number of features to use in the distance function
+     * @param config The configuration of the algorithm, with hammingCandidates
+     */
+    HammingFilter(std::vector<float>& dataTraining,
+                  std::vector<unsigned int>& labelsTraining,
+                  float (*distanceFunction)(std::vector<float>&,
+                                            std::vector<float>&,
+                                            unsigned int,
+                                            unsigned int,
+                                            unsigned int),
+                  unsigned int nFeatures,
+                  const Config& config);
+
+    std::vector<std::pair<float, unsigned int>> getNearestTuples(std::vector<float>& dataTest, unsigned int ptrDataTest, unsigned int k) const override;
+};
+
+#endif
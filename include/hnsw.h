@@ -0,0 +1,103 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file hnsw.h
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Function declarations of the Hierarchical Navigable Small World graph
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+#ifndef HNSW_H
+#define HNSW_H
+
+/********************************* Includes *******************************/
+#include <vector>
+
+#include "neighborIndex.h"
+
+/******************************** Constants *******************************/
+const unsigned int HNSW_SEED = 42; /**< Seed of the levels of the tuples, the graph is the same in every run */
+
+/******************************** Structures ******************************/
+
+/**
+ * @brief Approximate index that links each tuple of the training data with its nearest tuples in a
+ * hierarchy of graphs, the upper levels have fewer tuples and longer links. A query descends
+ * greedily from the top level and explores the bottom level keeping the efSearch nearest tuples
+ * found, so efSearch trades recall for time
+ */
+class HNSW : public NeighborIndex {
+   private:
+    mutable std::vector<float> points;                       /**< The nFeatures features of each tuple */
+    std::vector<std::vector<std::vector<unsigned int>>> links; /**< Neighbors of each tuple in each of its levels */
+    float (*distanceFunction)(std::vector<float>&,
+                              std::vector<float>&,
+                              unsigned int,
+                              unsigned int,
+                              unsigned int); /**< Distance function used */
+    unsigned int nFeatures;                                  /**< Number of features of the tuples */
+    unsigned int M;                                          /**< Links of each tuple in the upper levels, 2 * M in the bottom one */
+    unsigned int efConstruction;                             /**< Candidates explored to link a new tuple */
+    unsigned int efSearch;                                   /**< Candidates explored by a query */
+    unsigned int entryPoint;                                 /**< Tuple of the top level where the searches start */
+    int maxLevel;                                            /**< Top level of the graph */
+
+    /**
+     * @brief Explore a level from some entry points
+     * @param dataQuery The data of the query tuple
+     * @param ptrDataQuery The pointer to the query tuple
+     * @param entryPoints Pairs of distance and tuple where the exploration starts
+     * @param ef Number of nearest tuples kept
+     * @param level Level explored
+     * @return The ef nearest pairs of distance and tuple found, sorted by distance
+     */
+    std::vector<std::pair<float, unsigned int>> searchLevel(std::vector<float>& dataQuery, unsigned int ptrDataQuery, const std::vector<std::pair<float, unsigned int>>& entryPoints, unsigned int ef, int level) const;
+
+    /**
+     * @brief Select the links of a tuple among its candidates, a candidate nearer to a selected
+     * link than to the tuple is skipped so the links go in different directions
+     * @param candidates Pairs of distance and tuple sorted by distance
+     * @param maxLinks Maximum number of links
+     * @return The tuples selected
+     */
+    std::vector<unsigned int> selectLinks(const std::vector<std::pair<float, unsigned int>>& candidates, unsigned int maxLinks) const;
+
+    /**
+     * @brief Insert a tuple in the graph
+     * @param tuple Position of the tuple in the training data
+     * @param level Top level of the tuple
+     */
+    void insert(unsigned int tuple, int level);
+
+   public:
+    /**
+     * @brief Build the graph inserting the tuples one by one
+     * @param dataTraining The training data
+     * @param labelsTraining The labels of the training data
+     * @param distanceFunction The distance function to use
+     * @param nFeatures The number of features to use in the distance function
+     * @param config The configuration of the algorithm, with hnswM, hnswEfConstruction and hnswEfSearch
+     */
+    HNSW(std::vector<float>& dataTraining,
+         std::vector<unsigned int>& labelsTraining,
+         float (*distanceFunction)(std::vector<float>&,
+                                   std::vector<float>&,
+                                   unsigned int,
+                                   unsigned int,
+                                   unsigned int),
+         unsigned int nFeatures,
+         const Config& config);
+
+    std::vector<std::pair<float, unsigned int>> getNearestTuples(std::vector<float>& dataTest, unsigned int ptrDataTest, unsigned int k) const override;
+};
+
+#endif
@@ -0,0 +1,133 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file httpClient.h
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Function declarations of the HTTP/1.1 over TLS client
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+#ifndef HTTP_CLIENT_H
+#define HTTP_CLIENT_H
+
+/********************************* Includes *******************************/
+#include <openssl/ssl.h>
+
+#include <map>
+#include <string>
+
+/******************************** Constants *******************************/
+const unsigned int HTTP_BUFFER_SIZE = 16384; /**< Size of the buffer used to read from the TLS connection */
+const unsigned int HTTP_TIMEOUT_SECONDS = 10; /**< Seconds that connecting, sending or receiving can wait, then the request fails */
+
+/******************************** Structures ******************************/
+
+/**
+ * @brief Response of an HTTP request
+ */
+typedef struct HttpResponse {
+    int status;                                 /**< Status code, -1 if the request failed */
+    std::map<std::string, std::string> headers; /**< Headers with the name in lowercase */
+    std::string body;                           /**< Body already decoded from the chunked encoding */
+} HttpResponse;
+
+/**
+ * @brief Class that implements an HTTP/1.1 client over TLS. The SSL_CTX lives as long as the
+ * client and the connection is kept alive between requests, reconnecting only when the server
+ * closes it. Reads are buffered and responses are framed by Content-Length or chunked encoding
+ */
+class HttpClient {
+   private:
+    std::string host;                /**< Host name */
+    int port;                        /**< Port */
+    SSL_CTX *ctx;                    /**< TLS context shared by every connection of the client */
+    SSL *ssl;                        /**< TLS connection, NULL if not connected */
+    int sock;                        /**< Socket descriptor, -1 if not connected */
+    char buffer[HTTP_BUFFER_SIZE];   /**< Buffer with the data read but not consumed */
+    unsigned int bufferBegin;        /**< First byte not consumed of the buffer */
+    unsigned int bufferEnd;          /**< Last byte read in the buffer */
+
+    /**
+     * @brief Open the socket and do the TLS handshake with the server
+     * @return true if success, false if error
+     */
+    bool connectToServer();
+
+    /**
+     * @brief Check if the connection is still open, the server could have closed it while idle
+     * @return true if the connection can be reused, false otherwise
+     */
+    bool isAlive();
+
+    /**
+     * @brief Read from the TLS connection as much as fits in the buffer
+     * @return true if some data has been read, false if the connection is closed or failed
+     */
+    bool fillBuffer();
+
+    /**
+     * @brief Read a line finished in CRLF
+     * @param line The line read without the CRLF
+     * @return true if success, false if error
+     */
+    bool readLine(std::string &line);
+
+    /**
+     * @brief Read exactly n bytes and append them to out
+     * @param n Number of bytes to read
+     * @param out String where the bytes are appended
+     * @return true if success, false if error
+     */
+    bool readBytes(unsigned long n, std::string &out);
+
+    /**
+     * @brief Write the whole buffer to the TLS connection
+     * @param data Data to send
+     * @return true if success, false if error
+     */
+    bool writeAll(const std::string &data);
+
+    /**
+     * @brief Read the status line, headers and body of a response
+     * @param response The response read
+     * @return true if success, false if error
+     */
+    bool readResponse(HttpResponse &response);
+
+   public:
+    /**
+     * @brief Constructor
+     * @param host Host name
+     * @param port Port
+     * @param caFile File with the certificates to verify the server, if NULL the ones of the system
+     */
+    HttpClient(const char *host, int port, const char *caFile = NULL);
+
+    /**
+     * @brief Destructor, close the connection and free the TLS context
+     */
+    ~HttpClient();
+
+    /**
+     * @brief Do a GET request reusing the connection if it is still open
+     * @param path Path of the resource
+     * @return HttpResponse with status -1 if the request failed
+     */
+    HttpResponse get(const std::string &path);
+
+    /**
+     * @brief Close the connection, the next request opens a new one
+     */
+    void closeConnection();
+};
+
+#endif
@@ -0,0 +1,118 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file ivfpq.h
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Function declarations of the inverted file index with product quantization
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+#ifndef IVFPQ_H
+#define IVFPQ_H
+
+/********************************* Includes *******************************/
+#include <stdint.h>
+
+#include <vector>
+
+#include "neighborIndex.h"
+
+/******************************** Constants *******************************/
+const unsigned int PQ_CENTROIDS = 256;        /**< Centroids of each sub-quantizer, a code is one byte */
+const unsigned int KMEANS_ITERATIONS = 20;    /**< Iterations of the k-means that trains the centroids */
+const unsigned int KMEANS_SEED = 42;          /**< Seed of the initial centroids */
+
+/******************************** Structures ******************************/
+
+/**
+ * @brief Approximate index that assigns each tuple of the training data to its nearest coarse
+ * centroid and stores only the product quantization code of its residual, one byte for each of
+ * pqSubspaces groups of features. A query scans the ivfProbe nearest lists adding the distances
+ * precomputed from its residual to the centroids of each group. The codes approximate the
+ * euclidean distance, the ivfRerank best candidates are compared with the training data using the
+ * distance function. Without re-rank the index keeps no reference to the training data and answers
+ * from the codes, one byte per group instead of the floats of the tuple. ivfLists 0 uses about the
+ * square root of the number of tuples
+ */
+class IVFPQ : public NeighborIndex {
+   private:
+    std::vector<float>* dataTraining;                 /**< Training data, only read to re-rank, NULL without re-rank */
+    float (*distanceFunction)(std::vector<float>&,
+                              std::vector<float>&,
+                              unsigned int,
+                              unsigned int,
+                              unsigned int);        /**< Distance function used to re-rank */
+    unsigned int nFeatures;                           /**< Number of features of the tuples */
+    unsigned int stride;                              /**< Features of each tuple of the training data */
+    unsigned int nProbe;                              /**< Lists scanned by a query */
+    unsigned int nRerank;                             /**< Candidates re-ranked with the distance function */
+    unsigned int nCodes;                              /**< Centroids of each sub-quantizer, PQ_CENTROIDS or less with few tuples */
+    std::vector<float> coarseCentroids;               /**< The nFeatures features of each coarse centroid */
+    std::vector<unsigned int> subspaces;              /**< First feature of each group, and nFeatures at the end */
+    std::vector<float> codebooks;                     /**< PQ_CENTROIDS centroids of each group, the features of a group together */
+    std::vector<std::vector<unsigned int>> listTuples; /**< Position in the training data of the tuples of each list */
+    std::vector<std::vector<uint8_t>> listCodes;      /**< Codes of the tuples of each list, one byte for each group */
+
+    /**
+     * @brief Get the squared euclidean distance between two vectors
+     * @param a The first vector
+     * @param b The second vector
+     * @param n The number of values
+     * @return The squared distance
+     */
+    static float squaredDistance(const float* a, const float* b, unsigned int n);
+
+    /**
+     * @brief Train centroids with k-means
+     * @param data The vectors, one after the other
+     * @param nVectors The number of vectors
+     * @param dimension The values of each vector
+     * @param nCentroids The number of centroids
+     * @return The centroids, one after the other
+     */
+    static std::vector<float> kmeans(const std::vector<float>& data, unsigned int nVectors, unsigned int dimension, unsigned int nCentroids);
+
+    /**
+     * @brief Get the nearest centroid of a vector
+     * @param vector The vector
+     * @param centroids The centroids, one after the other
+     * @param nCentroids The number of centroids
+     * @param dimension The values of each vector
+     * @return The index of the nearest centroid
+     */
+    static unsigned int nearestCentroid(const float* vector, const float* centroids, unsigned int nCentroids, unsigned int dimension);
+
+   public:
+    /**
+     * @brief Train the centroids and encode the training data
+     * @param dataTraining The training data, it must outlive the index only if ivfRerank is set
+     * @param labelsTraining The labels of the training data
+     * @param distanceFunction The distance function to use to re-rank
+     * @param nFeatures The number of features to use in the distance function
+     * @param config The configuration of the algorithm, with ivfLists, ivfProbe, pqSubspaces and ivfRerank
+     */
+    IVFPQ(std::vector<float>& dataTraining,
+          std::vector<unsigned int>& labelsTraining,
+          float (*distanceFunction)(std::vector<float>&,
+                                    std::vector<float>&,
+                                    unsigned int,
+                                    unsigned int,
+                                    unsigned int),
+          unsigned int nFeatures,
+          const Config& config);
+
+    std::vector<std::pair<float, unsigned int>> getNearestTuples(std::vector<float>& dataTest, unsigned int ptrDataTest, unsigned int k) const override;
+
+    bool usesTrainingData() const override;
+};
+
+#endif
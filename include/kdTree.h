@@ -0,0 +1,106 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file kdTree.h
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Function declarations of the kd-tree
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+#ifndef KDTREE_H
+#define KDTREE_H
+
+/********************************* Includes *******************************/
+#include <queue>
+#include <vector>
+
+#include "neighborIndex.h"
+
+/******************************** Constants *******************************/
+const unsigned int KDTREE_LEAF_SIZE = 16;    /**< Maximum number of tuples of a leaf */
+const float KDTREE_PRUNE_SLACK = 1e-5;       /**< Relative margin so the rounding never prunes a neighbor */
+
+/******************************** Structures ******************************/
+
+/**
+ * @brief Exact kd-tree over the first nFeatures features of the training data. Each node splits
+ * its tuples by the median of the feature with the largest spread. A subtree is skipped when the
+ * distance to its splitting plane is larger than the k-th distance found, which is a lower bound
+ * of the euclidean and manhattan distances
+ */
+class KDTree : public NeighborIndex {
+   private:
+    /**
+     * @brief Node of the tree, a leaf if splitFeature is negative
+     */
+    typedef struct Node {
+        unsigned int begin;  /**< First tuple of the node in points */
+        unsigned int end;    /**< Last tuple of the node in points, not included */
+        int splitFeature;    /**< Feature used to split, negative in the leaves */
+        float splitValue;    /**< The tuples of left are <= splitValue and the ones of right >= */
+        unsigned int left;   /**< Index of the left child */
+        unsigned int right;  /**< Index of the right child */
+    } Node;
+
+    std::vector<Node> nodes;                   /**< Nodes of the tree, the root is the first one */
+    mutable std::vector<float> points;         /**< The nFeatures features of the tuples, in the order of the leaves */
+    std::vector<unsigned int> indexes;         /**< Position in the training data of each tuple of points */
+    float (*distanceFunction)(std::vector<float>&,
+                              std::vector<float>&,
+                              unsigned int,
+                              unsigned int,
+                              unsigned int); /**< Distance function used */
+    unsigned int nFeatures;                    /**< Number of features of the tuples */
+
+    /**
+     * @brief Build the node of a range of tuples and its children
+     * @param dataTraining The training data
+     * @param begin First tuple of the node in indexes
+     * @param end Last tuple of the node in indexes, not included
+     * @param config The configuration of the algorithm
+     * @return Index of the node
+     */
+    unsigned int build(std::vector<float>& dataTraining, unsigned int begin, unsigned int end, const Config& config);
+
+    /**
+     * @brief Search the nearest neighbors in a node and its children
+     * @param node Index of the node
+     * @param dataTest The reference to data test
+     * @param ptrDataTest The pointer to data test
+     * @param k The number of neighbors to find
+     * @param heap The k nearest pairs of distance and position found, the farthest on top
+     */
+    void search(unsigned int node, std::vector<float>& dataTest, unsigned int ptrDataTest, unsigned int k, std::priority_queue<std::pair<float, unsigned int>>& heap) const;
+
+   public:
+    /**
+     * @brief Build the tree
+     * @param dataTraining The training data
+     * @param labelsTraining The labels of the training data
+     * @param distanceFunction The distance function to use, euclidean or manhattan
+     * @param nFeatures The number of features to use in the distance function
+     * @param config The configuration of the algorithm
+     */
+    KDTree(std::vector<float>& dataTraining,
+           std::vector<unsigned int>& labelsTraining,
+           float (*distanceFunction)(std::vector<float>&,
+                                     std::vector<float>&,
+                                     unsigned int,
+                                     unsigned int,
+                                     unsigned int),
+           unsigned int nFeatures,
+           const Config& config);
+
+    std::vector<std::pair<float, unsigned int>> getNearestTuples(std::vector<float>& dataTest, unsigned int ptrDataTest, unsigned int k) const override;
+};
+
+#endif
@@ -26,8 +26,15 @@
 
 #include "config.h"
 #include "energySaving.h"
+#include "neighborIndex.h"
 
 /******************************** Constants *******************************/
+const unsigned int DISTANCE_ABANDON_BLOCK = 8; /**< Features added between two checks of the bound, a SIMD register of floats */
+const unsigned int KNN_BATCH_QUERIES = 8;      /**< Queries of a batch that share each block of the training data */
+const unsigned int KNN_BATCH_TUPLES = 256;     /**< Training tuples of each block, they stay in cache for all the queries */
+const unsigned int DISTANCE_FIXED_MAX = 64;    /**< Widest kernel of a fixed number of features, there is one for each multiple of DISTANCE_ABANDON_BLOCK */
+const unsigned int SCAN_TILE_QUERIES = 8;      /**< Test tuples of a thread that share each tile of the training data in getAccuracies */
+const size_t SCAN_TILE_BYTES = 512 * 1024;     /**< L2 size assumed when the system does not give it, a tile takes half of it */
 
 /********************************* Methods ********************************/
 /**
@@ -43,7 +50,7 @@
  */
 std::vector<std::pair<float, unsigned int>> getDistances(std::vector<float>& dataTraining,
                                                          std::vector<float>& dataTest,
-                                                         std::vector<unsigned int> labelsTraining,
+                                                         std::vector<unsigned int>& labelsTraining,
                                                          float (*distanceFunction)(std::vector<float>&,
                                                                                    std::vector<float>&,
                                                                                    unsigned int,
@@ -53,6 +60,33 @@ std::vector<std::pair<float, unsigned int>> getDistances(std::vector<float>& dat
                                                          unsigned int nFeatures,
                                                          const Config& config);
 
+/**
+ * @brief Get the k nearest training tuples to the test tuple. Only the k best are kept, so a
+ * distance with an early abandoning version stops adding features as soon as it is larger than
+ * the k-th distance found. The result is the same as the first k of getDistances
+ * @param k The number of neighbors to find
+ * @param dataTraining The reference to training data
+ * @param dataTest The reference to data test
+ * @param labelsTraining The reference to labels of training data
+ * @param distanceFunction The distance function to use
+ * @param ptrDataTest The pointer to data test, where use to select one test tuple
+ * @param nFeatures The number of features to use in the distance function
+ * @param config The configuration of the algorithm
+ * @return vector with the pairs of distance and label of the k nearest, sorted by distance
+ */
+std::vector<std::pair<float, unsigned int>> getNearestDistances(int k,
+                                                                std::vector<float>& dataTraining,
+                                                                std::vector<float>& dataTest,
+                                                                std::vector<unsigned int>& labelsTraining,
+                                                                float (*distanceFunction)(std::vector<float>&,
+                                                                                          std::vector<float>&,
+                                                                                          unsigned int,
+                                                                                          unsigned int,
+                                                                                          unsigned int),
+                                                                unsigned int ptrDataTest,
+                                                                unsigned int nFeatures,
+                                                                const Config& config);
+
 /**
  * @brief Create a map with
  * @param k number of neighbors used to classify
@@ -71,6 +105,7 @@ unsigned int getMostFrequentClass(int k, std::vector<std::pair<float, unsigned i
  * @param ptrDataTest The pointer to data test, where use to select one test tuple
  * @param nFeatures The number of features to use in the distance function
  * @param config The configuration of the algorithm
+ * @param index Index built for nFeatures, NULL to scan the whole training data
  * @return label predicted
  */
 unsigned int KNN(int k,
@@ -84,7 +119,63 @@ unsigned int KNN(int k,
                                            unsigned int),
                  unsigned int ptrDataTest,
                  unsigned int nFeatures,
-                 const Config& config);
+                 const Config& config,
+                 const NeighborIndex* index = NULL);
+
+/**
+ * @brief Classify a batch of queries with the KNN algorithm, the training data is traversed
+ * once for all the queries of the batch
+ * @param k The number of neighbors to find
+ * @param dataTraining The training data
+ * @param labelsTraining The labels of the training data
+ * @param distanceFunction The distance function to use
+ * @param queries The queries, one after the other with nFeatures values each one
+ * @param nQueries The number of queries
+ * @param nFeatures The number of features to use in the distance function
+ * @param config The configuration of the algorithm
+ * @param index Index built for nFeatures, NULL to scan the whole training data
+ * @return Vector with the label predicted for each query
+ */
+std::vector<unsigned int> KNNBatch(int k,
+                                   std::vector<float>& dataTraining,
+                                   std::vector<unsigned int>& labelsTraining,
+                                   float (*distanceFunction)(std::vector<float>&,
+                                                             std::vector<float>&,
+                                                             unsigned int,
+                                                             unsigned int,
+                                                             unsigned int),
+                                   std::vector<float>& queries,
+                                   unsigned int nQueries,
+                                   unsigned int nFeatures,
+                                   const Config& config,
+                                   const NeighborIndex* index = NULL);
+
+/**
+ * @brief Get the number of correct predictions of each k using a number of features
+ * @param nFeatures The number of features to use in the distance function
+ * @param minValueK The minimum value of K with starts
+ * @param maxValueK The maximum value of K with ends
+ * @param dataTraining The training data
+ * @param dataTest The Point to find the nearest neighbors
+ * @param labelsTraining The labels of the training data
+ * @param labelsTest The labels of the test data
+ * @param distanceFunction The distance function to use
+ * @param config The configuration of the algorithm
+ * @return Vector with the correct predictions of each k, from minValueK to maxValueK
+ */
+std::vector<unsigned int> getAccuracies(unsigned int nFeatures,
+                                        unsigned short minValueK,
+                                        unsigned short maxValueK,
+                                        std::vector<float>& dataTraining,
+                                        std::vector<float>& dataTest,
+                                        std::vector<unsigned int>& labelsTraining,
+                                        std::vector<unsigned int>& labelsTest,
+                                        float (*distanceFunction)(std::vector<float>&,
+                                                                  std::vector<float>&,
+                                                                  unsigned int,
+                                                                  unsigned int,
+                                                                  unsigned int),
+                                        const Config& config);
 
 /**
  * @brief Get the Best K object
@@ -113,7 +204,7 @@ std::pair<unsigned int, unsigned int> getBestHyperParamsHomogeneous(unsigned sho
                                                                     Energy& saving);
 
 /**
- * @brief Get the Best K object
+ * @brief Get the accuracies of a chunk of features
  * @param ptrFeatures The pointer that contents the number of feature to initialize for until ptrFeatures + chunkSize
  * @param minValueK The minimum value of K with starts
  * @param maxValueK The maximum value of K with ends
@@ -123,21 +214,24 @@ std::pair<unsigned int, unsigned int> getBestHyperParamsHomogeneous(unsigned sho
  * @param labelsTest The labels of the test data
  * @param distanceFunction The distance function to use
  * @param config The configuration of the algorithm
- * @return Vector with the best K, best features, and accuracy
- */
-std::vector<unsigned int> getBestHyperParamsHeterogeneous(unsigned long ptrFeatures,
-                                                          unsigned short minValueK,
-                                                          unsigned short maxValueK,
-                                                          std::vector<float>& dataTraining,
-                                                          std::vector<float>& dataTest,
-                                                          std::vector<unsigned int>& labelsTraining,
-                                                          std::vector<unsigned int>& labelsTest,
-                                                          float (*distanceFunction)(std::vector<float>&,
-                                                                                    std::vector<float>&,
-                                                                                    unsigned int,
-                                                                                    unsigned int,
-                                                                                    unsigned int),
-                                                          const Config& config);
+ * @param interrupted Function checked before each number of features, if it returns true the chunk is left
+ * @return Vector with the correct predictions of each k for each number of features of the chunk, one after the other,
+ * empty if the chunk has been interrupted
+ */
+std::vector<unsigned int> getAccuraciesHeterogeneous(unsigned long ptrFeatures,
+                                                     unsigned short minValueK,
+                                                     unsigned short maxValueK,
+                                                     std::vector<float>& dataTraining,
+                                                     std::vector<float>& dataTest,
+                                                     std::vector<unsigned int>& labelsTraining,
+                                                     std::vector<unsigned int>& labelsTest,
+                                                     float (*distanceFunction)(std::vector<float>&,
+                                                                               std::vector<float>&,
+                                                                               unsigned int,
+                                                                               unsigned int,
+                                                                               unsigned int),
+                                                     const Config& config,
+                                                     bool (*interrupted)() = NULL);
 
 /**
  * @brief Get the Confusion Matrix object
@@ -151,7 +245,7 @@ std::vector<std::vector<unsigned int>> getConfusionMatrix(std::vector<unsigned i
                                                           unsigned int nClasses);
 
 /**
- * @brief Get the Score from KNN
+ * @brief Get the Score from KNN, with the index selected by knnIndex for nFeatures
  *
  * @param k The number of neighbors to find
  * @param dataTraining The training data
@@ -176,6 +270,32 @@ std::pair<std::vector<unsigned int>, unsigned int> getScoreKNN(int k,
                                                                unsigned int nFeatures,
                                                                const Config& config);
 
+/**
+ * @brief Compare the index selected by knnIndex with the full scan of the training data and print
+ * its recall, the fraction of the k neighbors found that are as near as the k-th true neighbor,
+ * and the time of each query with both
+ * @param os stream output
+ * @param k The number of neighbors to find
+ * @param dataTraining The training data
+ * @param dataTest The test data, used as queries
+ * @param labelsTraining The labels of the training data
+ * @param distanceFunction The distance function to use
+ * @param nFeatures The number of features to use in the distance function
+ * @param config The configuration of the algorithm
+ */
+void reportIndexRecall(std::ostream& os,
+                       int k,
+                       std::vector<float>& dataTraining,
+                       std::vector<float>& dataTest,
+                       std::vector<unsigned int>& labelsTraining,
+                       float (*distanceFunction)(std::vector<float>&,
+                                                 std::vector<float>&,
+                                                 unsigned int,
+                                                 unsigned int,
+                                                 unsigned int),
+                       unsigned int nFeatures,
+                       const Config& config);
+
 /**
  * @brief Get the Euclidean Distance object
  * @param dataTraining The training data
@@ -206,4 +326,40 @@ float manhattanDistance(std::vector<float>& dataTraining,
                         unsigned int ptrDataTest,
                         unsigned int nFeatures);
 
+/**
+ * @brief Get the Euclidean Distance object, or leave it when it is larger than a bound. The
+ * bound is checked every DISTANCE_ABANDON_BLOCK features, the first ones of MRMR add the most
+ * @param dataTraining The training data
+ * @param dataTest The test data
+ * @param ptrDataTraining The pointer to data training, where use to select one training tuple
+ * @param ptrDataTest The pointer to data test, where use to select one test tuple
+ * @param nFeatures The number of features to use in the distance function
+ * @param bound The distance over which the result is not needed
+ * @return float with the same value as euclideanDistance, or INFINITY if it is larger than bound
+ */
+float euclideanDistanceBounded(std::vector<float>& dataTraining,
+                               std::vector<float>& dataTest,
+                               unsigned int ptrDataTraining,
+                               unsigned int ptrDataTest,
+                               unsigned int nFeatures,
+                               float bound);
+
+/**
+ * @brief Get the Manhattan object, or leave it when it is larger than a bound. The bound is
+ * checked every DISTANCE_ABANDON_BLOCK features
+ * @param dataTraining The training data
+ * @param dataTest The test data
+ * @param ptrDataTraining The pointer to data training, where use to select one training tuple
+ * @param ptrDataTest The pointer to data test, where use to select one test tuple
+ * @param nFeatures The number of features to use in the distance function
+ * @param bound The distance over which the result is not needed
+ * @return float with the same value as manhattanDistance, or INFINITY if it is larger than bound
+ */
+float manhattanDistanceBounded(std::vector<float>& dataTraining,
+                               std::vector<float>& dataTest,
+                               unsigned int ptrDataTraining,
+                               unsigned int ptrDataTest,
+                               unsigned int nFeatures,
+                               float bound);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,75 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file laesa.h
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Function declarations of the pivot table (LAESA)
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+#ifndef LAESA_H
+#define LAESA_H
+
+/********************************* Includes *******************************/
+#include <vector>
+
+#include "neighborIndex.h"
+
+/******************************** Constants *******************************/
+const float LAESA_PRUNE_SLACK = 1e-5; /**< Relative margin so the rounding never prunes a neighbor */
+
+/******************************** Structures ******************************/
+
+/**
+ * @brief Exact index that keeps the distances from every training tuple to laesaPivots pivots,
+ * chosen far from each other. By the triangle inequality |d(q, p) - d(x, p)| is a lower bound of
+ * d(q, x), so a query only computes the distance to the tuples whose bound is not larger than the
+ * k-th distance found. It works with any distance that satisfies the triangle inequality
+ */
+class LAESA : public NeighborIndex {
+   private:
+    std::vector<float>& dataTraining;     /**< Training data, read to compute the distances */
+    float (*distanceFunction)(std::vector<float>&,
+                              std::vector<float>&,
+                              unsigned int,
+                              unsigned int,
+                              unsigned int); /**< Distance function used */
+    unsigned int nFeatures;               /**< Number of features of the tuples */
+    unsigned int stride;                  /**< Features of each tuple of the training data */
+    std::vector<unsigned int> pivots;     /**< Position in the training data of each pivot */
+    std::vector<bool> isPivot;            /**< If each tuple of the training data is a pivot */
+    std::vector<float> table;             /**< Distances from each tuple to each pivot, the ones of a tuple together */
+    float maxDistance;                    /**< Maximum distance of the table, it scales the margin of the bounds */
+
+   public:
+    /**
+     * @brief Choose the pivots and compute the table
+     * @param dataTraining The training data, it must outlive the index
+     * @param labelsTraining The labels of the training data
+     * @param distanceFunction The distance function to use, it must satisfy the triangle inequality
+     * @param nFeatures The number of features to use in the distance function
+     * @param config The configuration of the algorithm, with laesaPivots
+     */
+    LAESA(std::vector<float>& dataTraining,
+          std::vector<unsigned int>& labelsTraining,
+          float (*distanceFunction)(std::vector<float>&,
+                                    std::vector<float>&,
+                                    unsigned int,
+                                    unsigned int,
+                                    unsigned int),
+          unsigned int nFeatures,
+          const Config& config);
+
+    std::vector<std::pair<float, unsigned int>> getNearestTuples(std::vector<float>& dataTest, unsigned int ptrDataTest, unsigned int k) const override;
+};
+
+#endif
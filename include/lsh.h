@@ -0,0 +1,91 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file lsh.h
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Function declarations of the locality-sensitive hashing index
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+#ifndef LSH_H
+#define LSH_H
+
+/********************************* Includes *******************************/
+#include <stdint.h>
+
+#include <unordered_map>
+#include <vector>
+
+#include "neighborIndex.h"
+
+/******************************** Constants *******************************/
+const unsigned int LSH_SEED = 42; /**< Seed of the projections, the tables are the same in every run */
+
+/******************************** Structures ******************************/
+
+/**
+ * @brief Approximate index that hashes the training tuples in lshTables tables. The key of a table
+ * joins lshHashes random projections: quantized with width lshWidth for the l2 (gaussian) and l1
+ * (cauchy) families, or its sign for the cosine family. The tuples that share a bucket with the
+ * query are the candidates, at most lshCandidates, and only they are compared with the distance
+ * function. A query with less than k candidates scans the whole training data
+ */
+class LSH : public NeighborIndex {
+   private:
+    std::vector<float>& dataTraining;     /**< Training data, read to compare the candidates */
+    float (*distanceFunction)(std::vector<float>&,
+                              std::vector<float>&,
+                              unsigned int,
+                              unsigned int,
+                              unsigned int); /**< Distance function used */
+    unsigned int nFeatures;               /**< Number of features of the tuples */
+    unsigned int stride;                  /**< Features of each tuple of the training data */
+    unsigned int nHashes;                 /**< Projections joined in the key of a table */
+    unsigned int maxCandidates;           /**< Maximum number of candidates of a query, 0 for no limit */
+    bool cosine;                          /**< Keys made of the signs of the projections */
+    float width;                          /**< Width of the buckets of a projection */
+    std::vector<float> projections;       /**< The nFeatures values of each projection, the ones of a table together */
+    std::vector<float> offsets;           /**< Random offset of each projection, in [0, width) */
+    std::vector<std::unordered_map<uint64_t, std::vector<unsigned int>>> tables; /**< Tuples of each bucket of each table */
+
+    /**
+     * @brief Get the key of a tuple in a table
+     * @param data The data of the tuple
+     * @param ptrData The pointer to the tuple
+     * @param table The table
+     * @return The key of the bucket
+     */
+    uint64_t getKey(const std::vector<float>& data, unsigned int ptrData, unsigned int table) const;
+
+   public:
+    /**
+     * @brief Hash the training data
+     * @param dataTraining The training data, it must outlive the index
+     * @param labelsTraining The labels of the training data
+     * @param distanceFunction The distance function to use
+     * @param nFeatures The number of features to use in the distance function
+     * @param config The configuration of the algorithm, with lshFamily, lshTables, lshHashes, lshWidth and lshCandidates
+     */
+    LSH(std::vector<float>& dataTraining,
+        std::vector<unsigned int>& labelsTraining,
+        float (*distanceFunction)(std::vector<float>&,
+                                  std::vector<float>&,
+                                  unsigned int,
+                                  unsigned int,
+                                  unsigned int),
+        unsigned int nFeatures,
+        const Config& config);
+
+    std::vector<std::pair<float, unsigned int>> getNearestTuples(std::vector<float>& dataTest, unsigned int ptrDataTest, unsigned int k) const override;
+};
+
+#endif
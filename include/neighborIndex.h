@@ -0,0 +1,97 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file neighborIndex.h
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Function declarations of the indexes that find the nearest neighbors without a full scan
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+#ifndef NEIGHBORINDEX_H
+#define NEIGHBORINDEX_H
+
+/********************************* Includes *******************************/
+#include <vector>
+
+#include "config.h"
+
+/******************************** Constants *******************************/
+
+/******************************** Structures ******************************/
+
+/**
+ * @brief Base class of the indexes built over the first nFeatures features of the training data.
+ * An index answers the same neighbors as the full scan of getDistances
+ */
+class NeighborIndex {
+   protected:
+    std::vector<unsigned int> labelsTraining; /**< Labels of the training data */
+
+   public:
+    /**
+     * @brief Constructor
+     * @param labelsTraining The labels of the training data
+     */
+    NeighborIndex(std::vector<unsigned int>& labelsTraining) : labelsTraining(labelsTraining) {}
+
+    /**
+     * @brief Destroy the index
+     */
+    virtual ~NeighborIndex() {}
+
+    /**
+     * @brief Get the k nearest tuples of the training data to a test tuple
+     * @param dataTest The reference to data test
+     * @param ptrDataTest The pointer to data test, where use to select one test tuple
+     * @param k The number of neighbors to find
+     * @return vector of the min(k, nTuples) pairs with distance and position in the training data
+     * of the nearest tuples, sorted by distance and by position on a tie
+     */
+    virtual std::vector<std::pair<float, unsigned int>> getNearestTuples(std::vector<float>& dataTest, unsigned int ptrDataTest, unsigned int k) const = 0;
+
+    /**
+     * @brief Get the k nearest neighbors of a test tuple
+     * @param dataTest The reference to data test
+     * @param ptrDataTest The pointer to data test, where use to select one test tuple
+     * @param k The number of neighbors to find
+     * @return vector of pairs with distance and label like getDistances, but only the first min(k, nTuples)
+     */
+    std::vector<std::pair<float, unsigned int>> getNeighbors(std::vector<float>& dataTest, unsigned int ptrDataTest, unsigned int k) const;
+
+    /**
+     * @brief Check if the index reads the training data when it answers
+     * @return false if it answers only from what it built, so the training data can be freed
+     */
+    virtual bool usesTrainingData() const { return true; }
+};
+
+/********************************* Methods ********************************/
+/**
+ * @brief Build the index selected by knnIndex for a number of features
+ * @param dataTraining The training data
+ * @param labelsTraining The labels of the training data
+ * @param distanceFunction The distance function to use
+ * @param nFeatures The number of features to use in the distance function
+ * @param config The configuration of the algorithm
+ * @return The index, or NULL if the full scan must be used
+ */
+NeighborIndex* createNeighborIndex(std::vector<float>& dataTraining,
+                                   std::vector<unsigned int>& labelsTraining,
+                                   float (*distanceFunction)(std::vector<float>&,
+                                                             std::vector<float>&,
+                                                             unsigned int,
+                                                             unsigned int,
+                                                             unsigned int),
+                                   unsigned int nFeatures,
+                                   const Config& config);
+
+#endif
@@ -0,0 +1,51 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file numaPlacement.h
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Function declarations of the placement of the training data and the threads in the NUMA nodes
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+#ifndef NUMAPLACEMENT_H
+#define NUMAPLACEMENT_H
+
+/********************************* Includes *******************************/
+#include <ostream>
+#include <vector>
+
+#include "config.h"
+
+/******************************** Constants *******************************/
+const char* const NUMA_NODES_PATH = "/sys/devices/system/node"; /**< Directory of the NUMA nodes of Linux */
+
+/********************************* Methods ********************************/
+/**
+ * @brief Place the training data and the OpenMP threads following config.numa and report the
+ * placement. The threads are bound to the nodes in blocks, then with replicate each node gets a
+ * copy of the training data first touched by one of its threads, and with interleave the pages of
+ * the training data are spread over all the nodes. It must be called after the training data has
+ * its final values and the same number of threads as the searches
+ * @param os stream output of the report
+ * @param dataTraining The training data, it must not change after the call
+ * @param config The configuration of the algorithm, with numa
+ */
+void placeNuma(std::ostream& os, std::vector<float>& dataTraining, const Config& config);
+
+/**
+ * @brief Get the copy of the data in the node of the calling thread
+ * @param data The data placed by placeNuma
+ * @return The replica of the node of the thread, or data itself if it has not been replicated
+ */
+std::vector<float>& getNumaLocalData(std::vector<float>& data);
+
+#endif
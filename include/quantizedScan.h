@@ -0,0 +1,83 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file quantizedScan.h
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Function declarations of the scan of the training data quantized to 8 bits
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+#ifndef QUANTIZEDSCAN_H
+#define QUANTIZEDSCAN_H
+
+/********************************* Includes *******************************/
+#include <stdint.h>
+
+#include <vector>
+
+#include "alignedAllocator.h"
+#include "neighborIndex.h"
+
+/******************************** Constants *******************************/
+const unsigned int QUANTIZED_LEVELS = 255; /**< Highest code, the codes are unsigned bytes */
+
+/******************************** Structures ******************************/
+
+/**
+ * @brief Approximate index that stores each feature of the training data in one byte, with the
+ * same scale for all the features, calibrated with the range of the training data, so the
+ * distance between the codes is proportional to the true one. A query is quantized with the same
+ * scale and compared with every tuple with integer kernels that accumulate in 32 bits: AVX-512
+ * VNNI or AVX2 for the euclidean distance, psadbw for the manhattan one, and a scalar version.
+ * The int8Rerank best candidates are compared with the training data using the distance function
+ */
+class QuantizedScan : public NeighborIndex {
+   private:
+    std::vector<float>& dataTraining;                        /**< Training data, only read to re-rank */
+    float (*distanceFunction)(std::vector<float>&,
+                              std::vector<float>&,
+                              unsigned int,
+                              unsigned int,
+                              unsigned int);               /**< Distance function used to re-rank */
+    unsigned int nFeatures;                                  /**< Number of features of the tuples */
+    unsigned int stride;                                     /**< Features of each tuple of the training data */
+    unsigned int codeStride;                                 /**< Bytes of each code, nFeatures padded with zeros to MEMORY_ALIGNMENT */
+    unsigned int nRerank;                                    /**< Candidates re-ranked with the distance function */
+    bool squared;                                            /**< If the kernel is the squared euclidean distance or the manhattan one */
+    float minValue;                                          /**< Value of the code 0 */
+    float scale;                                             /**< Difference of value between two consecutive codes */
+    std::vector<uint8_t, AlignedAllocator<uint8_t>> codes;   /**< Codes of the training data, one after the other */
+    uint32_t (*kernel)(const uint8_t*, const uint8_t*, unsigned int); /**< Distance between two codes, the best for the CPU */
+
+   public:
+    /**
+     * @brief Calibrate the scale and quantize the training data
+     * @param dataTraining The training data, it must outlive the index if int8Rerank is set
+     * @param labelsTraining The labels of the training data
+     * @param distanceFunction The distance function, manhattanDistance uses the L1 kernel and the others the L2 one
+     * @param nFeatures The number of features to use in the distance function
+     * @param config The configuration of the algorithm, with int8Rerank
+     */
+    QuantizedScan(std::vector<float>& dataTraining,
+                  std::vector<unsigned int>& labelsTraining,
+                  float (*distanceFunction)(std::vector<float>&,
+                                            std::vector<float>&,
+                                            unsigned int,
+                                            unsigned int,
+                                            unsigned int),
+                  unsigned int nFeatures,
+                  const Config& config);
+
+    std::vector<std::pair<float, unsigned int>> getNearestTuples(std::vector<float>& dataTest, unsigned int ptrDataTest, unsigned int k) const override;
+};
+
+#endif
@@ -0,0 +1,87 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file radixSelect.h
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Function declarations of the radix selection of the nearest distances packed in 64-bit keys
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+#ifndef RADIXSELECT_H
+#define RADIXSELECT_H
+
+/********************************* Includes *******************************/
+#include <stdint.h>
+#include <string.h>
+
+#include <vector>
+
+/******************************** Constants *******************************/
+const unsigned int RADIX_BITS = 8;                    /**< Bits of each digit, the 256 counters of a histogram fit in L1 */
+const unsigned int RADIX_BUCKETS = 1 << RADIX_BITS;   /**< Buckets of each pass */
+const unsigned int RADIX_SORT_MIN = 1024;             /**< Below it the keys are sorted by comparisons, faster than the passes */
+const unsigned int SORTING_NETWORK_MIN = 64;          /**< Keys of the smallest sorting network */
+const unsigned int SORTING_NETWORK_MAX = 512;         /**< Keys of the largest sorting network */
+const unsigned int SORTING_NETWORK_FROM = 48;         /**< Below it the keys are sorted by comparisons, the padding costs more */
+
+/********************************* Methods ********************************/
+
+/**
+ * @brief Pack a distance and a position in a key, the order of the keys as integers is the order
+ * of the distances and, on a tie, of the positions. The bits of a float are flipped so that the
+ * negative ones are under the positive ones
+ * @param distance The distance
+ * @param position The position of the training tuple
+ * @return The key
+ */
+inline uint64_t getDistanceKey(float distance, unsigned int position) {
+    uint32_t bits;
+    memcpy(&bits, &distance, sizeof(bits));
+    bits ^= (uint32_t)((int32_t)bits >> 31) | 0x80000000u;
+    return (uint64_t)bits << 32 | position;
+}
+
+/**
+ * @brief Get the distance of a key
+ * @param key The key
+ * @return The distance packed in it
+ */
+inline float getKeyDistance(uint64_t key) {
+    uint32_t bits = key >> 32;
+    bits ^= ((bits >> 31) - 1) | 0x80000000u;
+    float distance;
+    memcpy(&distance, &bits, sizeof(distance));
+    return distance;
+}
+
+/**
+ * @brief Get the position of a key
+ * @param key The key
+ * @return The position of the training tuple packed in it
+ */
+inline unsigned int getKeyPosition(uint64_t key) {
+    return (uint32_t)key;
+}
+
+/**
+ * @brief Leave the k smallest keys sorted at the beginning and drop the rest. The k-th key is
+ * found by a most significant digit pass per byte, that only keeps the keys of its bucket, then
+ * the k smallest are gathered and sorted by least significant digit passes. From
+ * SORTING_NETWORK_FROM to SORTING_NETWORK_MAX keys are all sorted by a bitonic network instead,
+ * without branches on the keys. The keys must be different, what the position of getDistanceKey ensures
+ * @param keys The keys, on return the k smallest sorted
+ * @param k The number of keys to keep
+ * @param scratch Memory reused between calls
+ */
+void selectSmallestKeys(std::vector<uint64_t>& keys, size_t k, std::vector<uint64_t>& scratch);
+
+#endif
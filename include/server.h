@@ -0,0 +1,116 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file server.h
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Function declarations of the classification server
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+#ifndef SERVER_H
+#define SERVER_H
+
+/********************************* Includes *******************************/
+#include <stdint.h>
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "config.h"
+#include "neighborIndex.h"
+
+/******************************** Constants *******************************/
+const char* const ERROR_SERVE_SOCKET = "Error: Cannot listen in the socket of the server.";
+const char* const ERROR_SERVE_PARAMS = "Error: serveK and serveNFeatures must be greater than 0 and serveNFeatures not greater than nFeatures";
+const char* const ERROR_SERVE_SHM = "Error: Cannot create the shared memory of the server, serveShmSlots must be a power of two.";
+const unsigned int SHM_SPIN_POLLS = 100000; /**< Empty polls of the ring before the server starts to sleep */
+const unsigned int SHM_IDLE_US = 50;        /**< Sleep between two polls of an idle ring */
+
+/******************************** Structures ******************************/
+
+/**
+ * @brief Header of a request frame. It is followed by nVectors * nFeatures floats and answered
+ * with nVectors labels of type uint32_t. Frames of more than serveMaxFrameVectors vectors close the
+ * connection
+ */
+typedef struct ServeHeader {
+    uint32_t nVectors;  /**< Number of feature vectors of the frame */
+    uint32_t nFeatures; /**< Number of features of each vector, must be serveNFeatures */
+} ServeHeader;
+
+/**
+ * @brief Class that keeps the training data and the tuned (k, nFeatures) resident and classifies
+ * the feature vectors sent by the clients through a Unix domain socket. The requests of all the
+ * clients are grouped in micro-batches that are classified together
+ */
+class KNNServer {
+   private:
+    /**
+     * @brief Request of a client waiting in the queue
+     */
+    typedef struct Request {
+        std::vector<float> features;                       /**< Feature vectors, one after the other */
+        unsigned int nVectors;                             /**< Number of feature vectors */
+        std::promise<std::vector<unsigned int>> labels;    /**< Labels predicted, set by the batcher */
+    } Request;
+
+    const Config& config;                     /**< Configuration of the program */
+    std::vector<float>& dataTraining;         /**< Training data, normalized and sorted by MRMR */
+    std::vector<unsigned int>& labelsTraining; /**< Labels of the training data */
+    float minValue;                           /**< Minimum value used to normalize the training data */
+    float maxValue;                           /**< Maximum value used to normalize the training data */
+    std::unique_ptr<NeighborIndex> index;     /**< Index built for serveNFeatures, NULL to scan the training data */
+    std::deque<Request*> queue;               /**< Requests waiting for the next batch */
+    std::mutex mutex;                         /**< Mutex of the queue */
+    std::condition_variable ready;            /**< Signaled when a request is queued */
+
+    /**
+     * @brief Read the frames of a client, queue them and write the labels back
+     * @param client Socket of the client
+     */
+    void handleClient(int client);
+
+    /**
+     * @brief Loop that takes the requests of the queue in batches of up to serveBatchSize vectors,
+     * waiting at most serveBatchWaitUs for the batch to fill, and classifies them
+     */
+    void batcher();
+
+    /**
+     * @brief Loop that classifies the vectors of the shared memory ring in batches of up to
+     * serveBatchSize vectors. It polls the ring without system calls while there are requests
+     */
+    void shmServe();
+
+   public:
+    /**
+     * @brief Constructor
+     * @param config Configuration of the program, with the serve parameters
+     * @param dataTraining Training data, normalized and sorted by MRMR, freed if the index answers without it
+     * @param labelsTraining Labels of the training data
+     * @param minValue Minimum value used to normalize, the queries are normalized with it
+     * @param maxValue Maximum value used to normalize, the queries are normalized with it
+     */
+    KNNServer(const Config& config, std::vector<float>& dataTraining, std::vector<unsigned int>& labelsTraining, float minValue, float maxValue);
+
+    /**
+     * @brief Listen in the socket, and in the shared memory ring if serveShm is set, and serve the
+     * clients forever
+     */
+    void run();
+};
+
+#endif
@@ -0,0 +1,190 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file shmRing.h
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Shared memory ring buffer between the serve mode and a client in the same host.
+ * The header does not depend on the rest of Hpknn, so the clients only need to include it
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+#ifndef SHMRING_H
+#define SHMRING_H
+
+/********************************* Includes *******************************/
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <atomic>
+
+/******************************** Constants *******************************/
+const uint32_t SHM_RING_MAGIC = 0x4b4e4e52; /**< Written by the server when the ring is ready */
+const size_t SHM_CACHE_LINE = 64;           /**< The indexes are in different cache lines */
+
+/******************************** Structures ******************************/
+
+/**
+ * @brief Header at the beginning of the shared memory, followed by nSlots slots of slotSize bytes.
+ * A slot has the nFeatures floats of a vector and the uint32_t label predicted after them.
+ * The client is the only writer of head and the server the only writer of done, so the ring
+ * needs no locks: slots in [done, head) wait to be classified and the labels of the slots before
+ * done are ready
+ */
+typedef struct ShmRingHeader {
+    std::atomic<uint32_t> magic;                           /**< SHM_RING_MAGIC when the server is ready */
+    uint32_t nFeatures;                                    /**< Features of each vector, serveNFeatures */
+    uint32_t nSlots;                                       /**< Number of slots, a power of two */
+    uint32_t slotSize;                                     /**< Bytes of each slot */
+    alignas(SHM_CACHE_LINE) std::atomic<uint64_t> head;  /**< Vectors submitted by the client */
+    alignas(SHM_CACHE_LINE) std::atomic<uint64_t> done;  /**< Vectors classified by the server */
+} ShmRingHeader;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "The indexes of the ring must be lock free to be shared between processes");
+
+/********************************* Methods ********************************/
+
+/**
+ * @brief Get the bytes of a slot
+ * @param nFeatures Features of each vector
+ * @return Bytes of the features and the label, rounded up to a cache line
+ */
+inline uint32_t shmSlotSize(uint32_t nFeatures) {
+    return ((nFeatures + 1) * sizeof(float) + SHM_CACHE_LINE - 1) / SHM_CACHE_LINE * SHM_CACHE_LINE;
+}
+
+/**
+ * @brief Get the bytes of the whole shared memory
+ * @param nFeatures Features of each vector
+ * @param nSlots Number of slots
+ * @return Bytes of the header and the slots
+ */
+inline size_t shmRingSize(uint32_t nFeatures, uint32_t nSlots) {
+    return sizeof(ShmRingHeader) + (size_t)nSlots * shmSlotSize(nFeatures);
+}
+
+/**
+ * @brief Get the features of a slot
+ * @param ring The header of the ring
+ * @param index Index of the vector, it wraps around the slots
+ * @return Pointer to the nFeatures floats of the slot
+ */
+inline float* shmSlotFeatures(ShmRingHeader* ring, uint64_t index) {
+    return (float*)((char*)(ring + 1) + (index & (ring->nSlots - 1)) * ring->slotSize);
+}
+
+/**
+ * @brief Get the label of a slot
+ * @param ring The header of the ring
+ * @param index Index of the vector, it wraps around the slots
+ * @return Pointer to the label of the slot
+ */
+inline uint32_t* shmSlotLabel(ShmRingHeader* ring, uint64_t index) {
+    return (uint32_t*)(shmSlotFeatures(ring, index) + ring->nFeatures);
+}
+
+/**
+ * @brief Client of the ring. There must be only one client for each ring. It submits raw feature
+ * vectors, the values of the first serveNFeatures features in MRMR order, and reads the labels in
+ * the same order. Neither of them makes system calls, the client polls until the labels are ready
+ */
+class ShmRingClient {
+   private:
+    ShmRingHeader* ring; /**< Header of the ring, NULL if it is not open */
+    size_t size;         /**< Bytes mapped */
+    uint64_t tail;       /**< Next vector whose label is read by the client */
+
+   public:
+    /**
+     * @brief Constructor, maps the ring created by the server
+     * @param name Name of the shared memory, serveShm in the configuration of the server
+     */
+    ShmRingClient(const char* name) : ring(NULL), size(0), tail(0) {
+        int fd = shm_open(name, O_RDWR, 0);
+        if (fd < 0) {
+            return;
+        }
+
+        ShmRingHeader header;
+        if (read(fd, &header, sizeof(header)) == sizeof(header) && header.magic.load(std::memory_order_acquire) == SHM_RING_MAGIC) {
+            this->size = shmRingSize(header.nFeatures, header.nSlots);
+            void* ptr = mmap(NULL, this->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (ptr != MAP_FAILED) {
+                this->ring = (ShmRingHeader*)ptr;
+                // A previous client could have left vectors in the ring, its labels are discarded
+                while (this->ring->done.load(std::memory_order_acquire) != this->ring->head.load(std::memory_order_relaxed)) {
+                }
+                this->tail = this->ring->head.load(std::memory_order_relaxed);
+            }
+        }
+        close(fd);
+    }
+
+    /**
+     * @brief Destructor, unmaps the ring
+     */
+    ~ShmRingClient() {
+        if (this->ring) {
+            munmap(this->ring, this->size);
+        }
+    }
+
+    /**
+     * @brief Check if the ring has been mapped
+     * @return true if the client can be used
+     */
+    bool isOpen() const {
+        return this->ring;
+    }
+
+    /**
+     * @brief Get the number of features of each vector
+     * @return The number of features expected by the server
+     */
+    uint32_t getNFeatures() const {
+        return this->ring->nFeatures;
+    }
+
+    /**
+     * @brief Submit a vector to be classified
+     * @param features The nFeatures values of the vector
+     * @return false if the ring is full, the labels must be received first
+     */
+    bool submit(const float* features) {
+        uint64_t head = this->ring->head.load(std::memory_order_relaxed);
+        if (head - this->tail >= this->ring->nSlots) {
+            return false;
+        }
+
+        memcpy(shmSlotFeatures(this->ring, head), features, this->ring->nFeatures * sizeof(float));
+        this->ring->head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Receive the label of the oldest vector submitted and not received
+     * @param label Where the label is stored
+     * @return false if the label is not ready yet
+     */
+    bool receive(uint32_t& label) {
+        if (this->tail == this->ring->done.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        label = *shmSlotLabel(this->ring, this->tail++);
+        return true;
+    }
+};
+
+#endif
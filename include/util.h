@@ -144,7 +144,7 @@ void printMatrix(const std::vector<std::vector<T>> &matrix) {
 }
 
 /**
- * @brief Function that read de data from files of config and fill vectors, if use function normalize get best scores
+ * @brief Function that read de data from files of config and fill vectors
  * @param dataTraining vector of data training
  * @param dataTest vector of data test
  * @param labelsTraining vector of labels training
@@ -164,11 +164,11 @@ void readDataFromFiles(std::vector<float> &dataTraining,
     {
 #pragma omp section
         {
-            dataTraining = config.normalize ? normalize(csvReader.readData<float>(config.dbDataTraining)) : csvReader.readData<float>(config.dbDataTraining);
+            dataTraining = csvReader.readData<float>(config.dbDataTraining);
         }
 #pragma omp section
         {
-            dataTest = config.normalize ? normalize(csvReader.readData<float>(config.dbDataTest)) : csvReader.readData<float>(config.dbDataTest);
+            dataTest = csvReader.readData<float>(config.dbDataTest);
         }
 #pragma omp section
         {
@@ -185,6 +185,25 @@ void readDataFromFiles(std::vector<float> &dataTraining,
     }
 }
 
+/**
+ * @brief normalize dataTraining and dataTest, if use function normalize get best scores
+ * @param dataTraining vector of data training
+ * @param dataTest vector of data test
+ */
+void normalizeData(std::vector<float> &dataTraining, std::vector<float> &dataTest) {
+#pragma omp parallel sections
+    {
+#pragma omp section
+        {
+            dataTraining = normalize(dataTraining);
+        }
+#pragma omp section
+        {
+            dataTest = normalize(dataTest);
+        }
+    }
+}
+
 /**
  * @brief sort dataTraining and dataTest by MRMR vector
  * @param dataTraining vector of data training
@@ -0,0 +1,109 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file vpTree.h
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Function declarations of the vantage-point tree
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+#ifndef VPTREE_H
+#define VPTREE_H
+
+/********************************* Includes *******************************/
+#include <queue>
+#include <vector>
+
+#include "neighborIndex.h"
+
+/******************************** Constants *******************************/
+const unsigned int VPTREE_LEAF_SIZE = 16;     /**< Maximum number of tuples of a leaf */
+const unsigned int VPTREE_TASK_SIZE = 2048;   /**< Minimum number of tuples of a subtree built in a new task */
+const float VPTREE_PRUNE_SLACK = 1e-5;        /**< Relative margin so the rounding never prunes a neighbor */
+
+/******************************** Structures ******************************/
+
+/**
+ * @brief Exact vantage-point tree over the first nFeatures features of the training data. It only
+ * uses the distances between tuples, so it works with any distance that satisfies the triangle
+ * inequality. Each node keeps a vantage point and the median radius of its tuples, the inner child
+ * has the tuples inside the radius and the outer child the rest
+ */
+class VPTree : public NeighborIndex {
+   private:
+    /**
+     * @brief Node of the tree, its vantage point is the tuple begin of points
+     */
+    typedef struct Node {
+        unsigned int begin;  /**< First tuple of the node in points */
+        unsigned int end;    /**< Last tuple of the node in points, not included */
+        bool leaf;           /**< The tuples of a leaf are compared one by one */
+        float radius;        /**< Tuples of inner are at <= radius of the vantage point and of outer at >= */
+        unsigned int inner;  /**< Index of the inner child */
+        unsigned int outer;  /**< Index of the outer child */
+    } Node;
+
+    std::vector<Node> nodes;                   /**< Nodes of the tree, the root is the first one */
+    mutable std::vector<float> points;         /**< The nFeatures features of the tuples, in the order of the nodes */
+    std::vector<unsigned int> indexes;         /**< Position in the training data of each tuple of points */
+    float (*distanceFunction)(std::vector<float>&,
+                              std::vector<float>&,
+                              unsigned int,
+                              unsigned int,
+                              unsigned int); /**< Distance function used */
+    unsigned int nFeatures;                    /**< Number of features of the tuples */
+
+    /**
+     * @brief Build the node of a range of tuples and its children, the big children in parallel tasks
+     * @param dataTraining The training data
+     * @param tuples Distance to the vantage point and position in the training data of each tuple
+     * @param begin First tuple of the node
+     * @param end Last tuple of the node, not included
+     * @param node Index of the node, already reserved
+     * @param nNodes Number of nodes reserved
+     * @param config The configuration of the algorithm
+     */
+    void build(std::vector<float>& dataTraining, std::vector<std::pair<float, unsigned int>>& tuples, unsigned int begin, unsigned int end, unsigned int node, unsigned int& nNodes, const Config& config);
+
+    /**
+     * @brief Search the nearest neighbors in a node and its children
+     * @param node Index of the node
+     * @param dataTest The reference to data test
+     * @param ptrDataTest The pointer to data test
+     * @param k The number of neighbors to find
+     * @param heap The k nearest pairs of distance and position found, the farthest on top
+     */
+    void search(unsigned int node, std::vector<float>& dataTest, unsigned int ptrDataTest, unsigned int k, std::priority_queue<std::pair<float, unsigned int>>& heap) const;
+
+   public:
+    /**
+     * @brief Build the tree with OpenMP tasks
+     * @param dataTraining The training data
+     * @param labelsTraining The labels of the training data
+     * @param distanceFunction The distance function to use, it must satisfy the triangle inequality
+     * @param nFeatures The number of features to use in the distance function
+     * @param config The configuration of the algorithm
+     */
+    VPTree(std::vector<float>& dataTraining,
+           std::vector<unsigned int>& labelsTraining,
+           float (*distanceFunction)(std::vector<float>&,
+                                     std::vector<float>&,
+                                     unsigned int,
+                                     unsigned int,
+                                     unsigned int),
+           unsigned int nFeatures,
+           const Config& config);
+
+    std::vector<std::pair<float, unsigned int>> getNearestTuples(std::vector<float>& dataTest, unsigned int ptrDataTest, unsigned int k) const override;
+};
+
+#endif
@@ -0,0 +1,157 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file checkpoint.cpp
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Implementation of the checkpoints of the hyperparameter search
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+/********************************* Includes *******************************/
+#include "checkpoint.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+/******************************** Constants *******************************/
+
+/********************************* Methods ********************************/
+
+/**
+ * @brief Get the fingerprint of the data and the parameters that change the accuracies of a search
+ * @param config The configuration of the search
+ * @return One line with the files of the data and the parameters
+ */
+static std::string getFingerprint(const Config& config) {
+    std::ostringstream os;
+    os << "data=" << config.dbDataTraining << ";labels=" << config.dbLabelsTraining << ";test=" << config.dbDataTest
+       << ";labelsTest=" << config.dbLabelsTest << ";MRMR=" << config.MRMR << ";nTuples=" << config.nTuples
+       << ";nFeatures=" << config.nFeatures << ";maxFeatures=" << config.maxFeatures << ";chunkSize=" << config.chunkSize
+       << ";normalize=" << config.normalize << ";sortingByMRMR=" << config.sortingByMRMR << ";dataPrecision=" << config.dataPrecision;
+    return os.str();
+}
+
+Checkpoint::Checkpoint(const std::string& filename, unsigned int nK, const Config& config)
+    : filename(filename), fingerprint(getFingerprint(config)), nK(nK), interval(config.checkpointInterval ? config.checkpointInterval : 1), pending(0) {
+    if (this->filename.empty()) {
+        return;
+    }
+
+    std::ifstream file(this->filename);
+    if (!file.is_open()) {
+        return;
+    }
+
+    std::string magic, fileFingerprint;
+    unsigned int fileNK = 0, nFeatures;
+    file >> magic >> fileNK;
+    file.ignore(1);
+    std::getline(file, fileFingerprint);
+    if (magic != CHECKPOINT_MAGIC || fileNK != this->nK || fileFingerprint != this->fingerprint) {
+        std::cerr << WARNING_CHECKPOINT_MISMATCH << std::endl;
+        return;
+    }
+
+    // Each line has the number of features followed by the accuracy of each k
+    while (file >> nFeatures) {
+        std::vector<unsigned int> accuracies(this->nK);
+        for (unsigned int k = 0; k < this->nK; ++k) {
+            file >> accuracies[k];
+        }
+        if (!file) {
+            break;
+        }
+        this->done[nFeatures] = accuracies;
+    }
+
+    std::cout << "Resuming from " << this->filename << " with " << this->done.size() << " numbers of features done" << std::endl;
+}
+
+bool Checkpoint::isDone(unsigned int nFeatures) const {
+    return this->done.count(nFeatures);
+}
+
+bool Checkpoint::isChunkDone(unsigned int ptrFeatures, unsigned int chunkSize) const {
+    for (unsigned int f = ptrFeatures + 1; f <= ptrFeatures + chunkSize; ++f) {
+        if (!this->isDone(f)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Checkpoint::add(unsigned int nFeatures, const std::vector<unsigned int>& accuracies) {
+    this->done[nFeatures] = accuracies;
+}
+
+void Checkpoint::chunkDone() {
+    if (++this->pending >= this->interval) {
+        this->save();
+    }
+}
+
+void Checkpoint::save() {
+    this->pending = 0;
+    if (this->filename.empty()) {
+        return;
+    }
+
+    std::string tmpFilename = this->filename + ".tmp";
+    FILE* file = fopen(tmpFilename.c_str(), "w");
+    check(!file, "%s\n", ERROR_CHECKPOINT_WRITE);
+
+    fprintf(file, "%s %u\n%s\n", CHECKPOINT_MAGIC, this->nK, this->fingerprint.c_str());
+    for (const auto& entry : this->done) {
+        fprintf(file, "%u", entry.first);
+        for (unsigned int accuracy : entry.second) {
+            fprintf(file, " %u", accuracy);
+        }
+        fprintf(file, "\n");
+    }
+
+    // The data must be on disk before the rename, otherwise a crash could leave an empty checkpoint
+    check(fflush(file) || fsync(fileno(file)) || fclose(file), "%s\n", ERROR_CHECKPOINT_WRITE);
+    check(rename(tmpFilename.c_str(), this->filename.c_str()), "%s\n", ERROR_CHECKPOINT_WRITE);
+
+    // The rename is an entry of the directory, it is on disk when the directory is synced
+    size_t slash = this->filename.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : (slash ? this->filename.substr(0, slash) : "/");
+    int fd = open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+    check(fd < 0 || fsync(fd) || close(fd), "%s\n", ERROR_CHECKPOINT_WRITE);
+}
+
+void Checkpoint::remove() {
+    if (!this->filename.empty()) {
+        ::remove(this->filename.c_str());
+    }
+}
+
+std::vector<unsigned int> Checkpoint::getBest(unsigned int minValueK) const {
+    unsigned int bestK = 0, bestNFeatures = 0, bestAccuracy = 0;
+
+    for (const auto& entry : this->done) {
+        for (unsigned int i = 0; i < entry.second.size(); ++i) {
+            if (entry.second[i] > bestAccuracy) {
+                bestAccuracy = entry.second[i];
+                bestK = i + minValueK;
+                bestNFeatures = entry.first;
+            }
+        }
+    }
+
+    return std::vector<unsigned int>{bestK, bestNFeatures, bestAccuracy};
+}
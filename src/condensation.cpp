@@ -0,0 +1,172 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file condensation.cpp
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Implementation of the reduction of the training data (Wilson editing and Hart condensing)
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+/********************************* Includes *******************************/
+#include "condensation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+
+#include "knn.h"
+
+/******************************** Constants *******************************/
+
+/********************************* Methods ********************************/
+std::vector<unsigned int> wilsonEditing(int k,
+                                        std::vector<float>& dataTraining,
+                                        std::vector<unsigned int>& labelsTraining,
+                                        float (*distanceFunction)(std::vector<float>&,
+                                                                  std::vector<float>&,
+                                                                  unsigned int,
+                                                                  unsigned int,
+                                                                  unsigned int),
+                                        unsigned int nFeatures,
+                                        const Config& config) {
+    unsigned int nTuples = dataTraining.size() / config.nFeatures;
+    std::vector<char> kept(nTuples, false);
+
+#pragma omp parallel for schedule(dynamic)
+    for (unsigned int i = 0; i < nTuples; ++i) {
+        // The k nearest without the tuple itself, the ties in the order of the training data
+        std::priority_queue<std::pair<float, unsigned int>> heap;
+        for (unsigned int j = 0; j < nTuples; ++j) {
+            if (j == i) {
+                continue;
+            }
+            std::pair<float, unsigned int> candidate(distanceFunction(dataTraining, dataTraining, j * config.nFeatures, i * config.nFeatures, nFeatures), j);
+            if (heap.size() < (size_t)k) {
+                heap.push(candidate);
+            } else if (candidate < heap.top()) {
+                heap.pop();
+                heap.push(candidate);
+            }
+        }
+        if (heap.empty()) {
+            kept[i] = true;
+            continue;
+        }
+
+        std::vector<std::pair<float, unsigned int>> distances(heap.size());
+        for (auto it = distances.rbegin(); it != distances.rend(); ++it) {
+            *it = std::make_pair(heap.top().first, labelsTraining[heap.top().second]);
+            heap.pop();
+        }
+        kept[i] = getMostFrequentClass(distances.size(), distances) == labelsTraining[i];
+    }
+
+    std::vector<unsigned int> positions;
+    for (unsigned int i = 0; i < nTuples; ++i) {
+        if (kept[i]) {
+            positions.push_back(i);
+        }
+    }
+
+    return positions;
+}
+
+std::vector<unsigned int> hartCondensing(std::vector<float>& dataTraining,
+                                         std::vector<unsigned int>& labelsTraining,
+                                         float (*distanceFunction)(std::vector<float>&,
+                                                                   std::vector<float>&,
+                                                                   unsigned int,
+                                                                   unsigned int,
+                                                                   unsigned int),
+                                         unsigned int nFeatures,
+                                         const Config& config,
+                                         const std::vector<unsigned int>& candidates) {
+    std::vector<unsigned int> subset;
+    if (candidates.empty()) {
+        return subset;
+    }
+
+    std::vector<char> inSubset(dataTraining.size() / config.nFeatures, false);
+    subset.push_back(candidates[0]);
+    inSubset[candidates[0]] = true;
+
+    bool added = true;
+    while (added) {
+        added = false;
+        for (unsigned int first = 0; first < candidates.size(); first += CONDENSATION_BLOCK) {
+            unsigned int last = std::min(first + CONDENSATION_BLOCK, (unsigned int)candidates.size());
+            std::vector<char> misclassified(last - first, false);
+
+            // The tuples of a block are classified against the same subset, so the block is parallel
+#pragma omp parallel for schedule(dynamic)
+            for (unsigned int c = first; c < last; ++c) {
+                unsigned int i = candidates[c];
+                if (inSubset[i]) {
+                    continue;
+                }
+                float minDistance = INFINITY;
+                unsigned int nearest = subset[0];
+                for (unsigned int s : subset) {
+                    float distance = distanceFunction(dataTraining, dataTraining, s * config.nFeatures, i * config.nFeatures, nFeatures);
+                    if (distance < minDistance) {
+                        minDistance = distance;
+                        nearest = s;
+                    }
+                }
+                misclassified[c - first] = labelsTraining[nearest] != labelsTraining[i];
+            }
+
+            for (unsigned int c = first; c < last; ++c) {
+                if (misclassified[c - first]) {
+                    subset.push_back(candidates[c]);
+                    inSubset[candidates[c]] = true;
+                    added = true;
+                }
+            }
+        }
+    }
+
+    std::sort(subset.begin(), subset.end());
+    return subset;
+}
+
+void condenseTrainingData(std::vector<float>& dataTraining,
+                          std::vector<unsigned int>& labelsTraining,
+                          float (*distanceFunction)(std::vector<float>&,
+                                                    std::vector<float>&,
+                                                    unsigned int,
+                                                    unsigned int,
+                                                    unsigned int),
+                          unsigned int nFeatures,
+                          const Config& config) {
+    std::vector<unsigned int> positions;
+    if (config.condensation == "wilson" || config.condensation == "wilson-hart") {
+        positions = wilsonEditing(config.condensationK, dataTraining, labelsTraining, distanceFunction, nFeatures, config);
+    } else {
+        for (unsigned int i = 0; i < labelsTraining.size(); ++i) {
+            positions.push_back(i);
+        }
+    }
+    if (config.condensation == "hart" || config.condensation == "wilson-hart") {
+        positions = hartCondensing(dataTraining, labelsTraining, distanceFunction, nFeatures, config, positions);
+    }
+
+    // The positions are in order, so each tuple is moved to the same place or before it
+    for (unsigned int i = 0; i < positions.size(); ++i) {
+        std::copy(dataTraining.begin() + (size_t)positions[i] * config.nFeatures,
+                  dataTraining.begin() + (size_t)(positions[i] + 1) * config.nFeatures,
+                  dataTraining.begin() + (size_t)i * config.nFeatures);
+        labelsTraining[i] = labelsTraining[positions[i]];
+    }
+    dataTraining.resize((size_t)positions.size() * config.nFeatures);
+    labelsTraining.resize(positions.size());
+}
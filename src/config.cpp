@@ -41,11 +41,13 @@ Config::Config(int argc, char** argv) {
     parser.addExample("./bin/hpknn -h");
     parser.addExample("./bin/hpknn -conf \"config.json\"");
     parser.addExample("./bin/hpknn -mode [homo,hetero] -conf \"config.json\"");
+    parser.addExample("./bin/hpknn -mode serve -conf \"config.json\"");
 
     /************ Add arguments ***********/
     parser.addArg("-h", false, "Display usage instructions.");
     parser.addArg("-mode", true,
-                  "Two modes [homo,hetero] for heterogeneous platforms or homogeneous platforms.");
+                  "Modes [homo,hetero] for heterogeneous platforms or homogeneous platforms, or serve to classify "
+                  "the requests of the clients with serveK and serveNFeatures.");
     parser.addArg("-conf", true, "Name of the file containing the JSON configuration file.");
 
     /************ Parse and check the missing arguments ***********/
@@ -65,7 +67,7 @@ Config::Config(int argc, char** argv) {
     this->mode = parser.getValue<char*>("-mode");
 
     // Check if mode is valid
-    check(!(this->mode.compare("homo") || this->mode.compare("hetero")), "%s\n", ERROR_MODE);
+    check(this->mode != "homo" && this->mode != "hetero" && this->mode != "serve", "%s\n", ERROR_MODE);
 
     struct_mapping::reg(&Config::dbDataTest, "dbDataTest");
     struct_mapping::reg(&Config::dbLabelsTest, "dbLabelsTest");
@@ -80,7 +82,51 @@ Config::Config(int argc, char** argv) {
     struct_mapping::reg(&Config::maxFeatures, "maxFeatures");
     struct_mapping::reg(&Config::chunkSize, "chunkSize");
     struct_mapping::reg(&Config::savingEnergy, "savingEnergy");
+    struct_mapping::reg(&Config::energyApiHost, "energyApiHost", struct_mapping::Default{"api.preciodelaluz.org"});
+    struct_mapping::reg(&Config::energyApiPort, "energyApiPort", struct_mapping::Default{443});
+    struct_mapping::reg(&Config::energyApiPath, "energyApiPath", struct_mapping::Default{"/v1/prices/now?zone=PCB"});
+    struct_mapping::reg(&Config::energyApiCaFile, "energyApiCaFile", struct_mapping::Default{""});
     struct_mapping::reg(&Config::stridedHomo, "stridedHomo");
+    struct_mapping::reg(&Config::dataLayout, "dataLayout", struct_mapping::Default{"row"});
+    struct_mapping::reg(&Config::dataPrecision, "dataPrecision", struct_mapping::Default{"fp32"});
+    struct_mapping::reg(&Config::validatePrecision, "validatePrecision", struct_mapping::Default{false});
+    struct_mapping::reg(&Config::numa, "numa", struct_mapping::Default{"none"});
+    struct_mapping::reg(&Config::hugePages, "hugePages", struct_mapping::Default{"none"});
+    struct_mapping::reg(&Config::prefetchDistance, "prefetchDistance", struct_mapping::Default{4});
+    struct_mapping::reg(&Config::measureEnergy, "measureEnergy", struct_mapping::Default{false});
+    struct_mapping::reg(&Config::nRuns, "nRuns", struct_mapping::Default{0});
+    struct_mapping::reg(&Config::checkpointFile, "checkpointFile", struct_mapping::Default{""});
+    struct_mapping::reg(&Config::checkpointInterval, "checkpointInterval", struct_mapping::Default{1});
+    struct_mapping::reg(&Config::stragglerFactor, "stragglerFactor", struct_mapping::Default{0});
+    struct_mapping::reg(&Config::slaveTimeout, "slaveTimeout", struct_mapping::Default{0});
+    struct_mapping::reg(&Config::serveSocket, "serveSocket", struct_mapping::Default{"/tmp/hpknn.sock"});
+    struct_mapping::reg(&Config::serveK, "serveK", struct_mapping::Default{0});
+    struct_mapping::reg(&Config::serveNFeatures, "serveNFeatures", struct_mapping::Default{0});
+    struct_mapping::reg(&Config::serveBatchSize, "serveBatchSize", struct_mapping::Default{32});
+    struct_mapping::reg(&Config::serveBatchWaitUs, "serveBatchWaitUs", struct_mapping::Default{500});
+    struct_mapping::reg(&Config::serveMaxFrameVectors, "serveMaxFrameVectors", struct_mapping::Default{4096});
+    struct_mapping::reg(&Config::knnIndex, "knnIndex", struct_mapping::Default{"auto"});
+    struct_mapping::reg(&Config::kdTreeMaxFeatures, "kdTreeMaxFeatures", struct_mapping::Default{20});
+    struct_mapping::reg(&Config::laesaPivots, "laesaPivots", struct_mapping::Default{16});
+    struct_mapping::reg(&Config::hnswM, "hnswM", struct_mapping::Default{16});
+    struct_mapping::reg(&Config::hnswEfConstruction, "hnswEfConstruction", struct_mapping::Default{200});
+    struct_mapping::reg(&Config::hnswEfSearch, "hnswEfSearch", struct_mapping::Default{50});
+    struct_mapping::reg(&Config::ivfLists, "ivfLists", struct_mapping::Default{0});
+    struct_mapping::reg(&Config::ivfProbe, "ivfProbe", struct_mapping::Default{8});
+    struct_mapping::reg(&Config::pqSubspaces, "pqSubspaces", struct_mapping::Default{8});
+    struct_mapping::reg(&Config::ivfRerank, "ivfRerank", struct_mapping::Default{64});
+    struct_mapping::reg(&Config::lshFamily, "lshFamily", struct_mapping::Default{"l2"});
+    struct_mapping::reg(&Config::lshTables, "lshTables", struct_mapping::Default{8});
+    struct_mapping::reg(&Config::lshHashes, "lshHashes", struct_mapping::Default{8});
+    struct_mapping::reg(&Config::lshWidth, "lshWidth", struct_mapping::Default{1});
+    struct_mapping::reg(&Config::lshCandidates, "lshCandidates", struct_mapping::Default{0});
+    struct_mapping::reg(&Config::int8Rerank, "int8Rerank", struct_mapping::Default{64});
+    struct_mapping::reg(&Config::hammingCandidates, "hammingCandidates", struct_mapping::Default{256});
+    struct_mapping::reg(&Config::condensation, "condensation", struct_mapping::Default{"none"});
+    struct_mapping::reg(&Config::condensationK, "condensationK", struct_mapping::Default{3});
+    struct_mapping::reg(&Config::reportRecall, "reportRecall", struct_mapping::Default{false});
+    struct_mapping::reg(&Config::serveShm, "serveShm", struct_mapping::Default{""});
+    struct_mapping::reg(&Config::serveShmSlots, "serveShmSlots", struct_mapping::Default{1024});
 
     std::ifstream fileConfig(filename.c_str());
     std::stringstream buffer;
@@ -91,12 +137,22 @@ Config::Config(int argc, char** argv) {
     this->TAM = this->nTuples * this->nFeatures;
     this->TAM_MAX_FEATURES = this->nTuples * this->maxFeatures;
 
+    check(this->knnIndex != "brute" && this->knnIndex != "auto" && this->knnIndex != "kdtree" && this->knnIndex != "vptree" && this->knnIndex != "hnsw" && this->knnIndex != "ivfpq" && this->knnIndex != "lsh" && this->knnIndex != "laesa" && this->knnIndex != "int8" && this->knnIndex != "hamming", "%s\n", ERROR_KNN_INDEX);
+    check(this->dataLayout != "row" && this->dataLayout != "column", "%s\n", ERROR_DATA_LAYOUT);
+    check((this->dataPrecision != "fp32" && this->dataPrecision != "fp16" && this->dataPrecision != "bf16") ||
+              (this->dataPrecision != "fp32" && this->dataLayout != "column"),
+          "%s\n", ERROR_DATA_PRECISION);
+    check(this->numa != "none" && this->numa != "replicate" && this->numa != "interleave", "%s\n", ERROR_NUMA);
+    check(this->hugePages != "none" && this->hugePages != "transparent" && this->hugePages != "explicit", "%s\n", ERROR_HUGE_PAGES);
+    check(this->condensation != "none" && this->condensation != "wilson" && this->condensation != "hart" && this->condensation != "wilson-hart", "%s\n", ERROR_CONDENSATION);
+    check(this->lshFamily != "l2" && this->lshFamily != "l1" && this->lshFamily != "cosine", "%s\n", ERROR_LSH_FAMILY);
+
     /************ Checks for both modes ***********/
     /************ Check if in mode hetero have min two process ***********/
     if (this->mode.compare("hetero") == 0) {
         check(MPI::COMM_WORLD.Get_size() < 2, "%s\n", ERROR_NPROCESS_HETERO);
         check(this->TAM_MAX_FEATURES % this->chunkSize, "%s\n", ERROR_CHUNKSIZE_HETERO);
-    } else {
+    } else if (this->mode.compare("homo") == 0) {
         /************ Check if size of data is divisible by the number of processors ***********/
         check(this->maxFeatures % MPI::COMM_WORLD.Get_size(), "%s\n", ERROR_NPROCESS_HOMO);
     }
@@ -119,7 +175,51 @@ std::ostream& operator<<(std::ostream& os, const Config& o) {
     os << "maxFeatures: " << o.maxFeatures << std::endl;
     os << "chunkSize: " << o.chunkSize << std::endl;
     os << "savingEnergy: " << o.savingEnergy << std::endl;
+    os << "energyApiHost: " << o.energyApiHost << std::endl;
+    os << "energyApiPort: " << o.energyApiPort << std::endl;
+    os << "energyApiPath: " << o.energyApiPath << std::endl;
+    os << "energyApiCaFile: " << o.energyApiCaFile << std::endl;
     os << "stridedHomo: " << o.stridedHomo << std::endl;
+    os << "dataLayout: " << o.dataLayout << std::endl;
+    os << "dataPrecision: " << o.dataPrecision << std::endl;
+    os << "validatePrecision: " << o.validatePrecision << std::endl;
+    os << "numa: " << o.numa << std::endl;
+    os << "hugePages: " << o.hugePages << std::endl;
+    os << "prefetchDistance: " << o.prefetchDistance << std::endl;
+    os << "measureEnergy: " << o.measureEnergy << std::endl;
+    os << "nRuns: " << o.nRuns << std::endl;
+    os << "checkpointFile: " << o.checkpointFile << std::endl;
+    os << "checkpointInterval: " << o.checkpointInterval << std::endl;
+    os << "stragglerFactor: " << o.stragglerFactor << std::endl;
+    os << "slaveTimeout: " << o.slaveTimeout << std::endl;
+    os << "serveSocket: " << o.serveSocket << std::endl;
+    os << "serveK: " << o.serveK << std::endl;
+    os << "serveNFeatures: " << o.serveNFeatures << std::endl;
+    os << "serveBatchSize: " << o.serveBatchSize << std::endl;
+    os << "serveBatchWaitUs: " << o.serveBatchWaitUs << std::endl;
+    os << "serveMaxFrameVectors: " << o.serveMaxFrameVectors << std::endl;
+    os << "knnIndex: " << o.knnIndex << std::endl;
+    os << "kdTreeMaxFeatures: " << o.kdTreeMaxFeatures << std::endl;
+    os << "laesaPivots: " << o.laesaPivots << std::endl;
+    os << "hnswM: " << o.hnswM << std::endl;
+    os << "hnswEfConstruction: " << o.hnswEfConstruction << std::endl;
+    os << "hnswEfSearch: " << o.hnswEfSearch << std::endl;
+    os << "ivfLists: " << o.ivfLists << std::endl;
+    os << "ivfProbe: " << o.ivfProbe << std::endl;
+    os << "pqSubspaces: " << o.pqSubspaces << std::endl;
+    os << "ivfRerank: " << o.ivfRerank << std::endl;
+    os << "lshFamily: " << o.lshFamily << std::endl;
+    os << "lshTables: " << o.lshTables << std::endl;
+    os << "lshHashes: " << o.lshHashes << std::endl;
+    os << "lshWidth: " << o.lshWidth << std::endl;
+    os << "lshCandidates: " << o.lshCandidates << std::endl;
+    os << "int8Rerank: " << o.int8Rerank << std::endl;
+    os << "hammingCandidates: " << o.hammingCandidates << std::endl;
+    os << "condensation: " << o.condensation << std::endl;
+    os << "condensationK: " << o.condensationK << std::endl;
+    os << "reportRecall: " << o.reportRecall << std::endl;
+    os << "serveShm: " << o.serveShm << std::endl;
+    os << "serveShmSlots: " << o.serveShmSlots << std::endl;
 
     return os;
 }
@@ -0,0 +1,58 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file dataset.cpp
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Implementation of the Dataset class
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+/********************************* Includes *******************************/
+#include "dataset.h"
+
+/******************************** Constants *******************************/
+
+/********************************* Methods ********************************/
+Dataset::Dataset(const std::vector<float>& rows,
+                 unsigned int stride,
+                 unsigned int nFeatures,
+                 DataLayout layout,
+                 DataPrecision precision,
+                 HugePages hugePages)
+    : data(AlignedAllocator<float>(hugePages)),
+      halfData(AlignedAllocator<uint16_t>(hugePages)),
+      nTuples(rows.size() / stride),
+      nFeatures(nFeatures),
+      layout(layout),
+      precision(precision),
+      stride(getPaddedLength(layout == ROW_MAJOR ? nFeatures : this->nTuples)) {
+    // The padding is zero, so it adds nothing to a distance. Only the buffer of the precision is used
+    size_t size = (size_t)(layout == ROW_MAJOR ? this->nTuples : nFeatures) * this->stride;
+    if (precision == PRECISION_FP32) {
+        this->data.resize(size, 0);
+    } else {
+        this->halfData.resize(size, 0);
+    }
+
+#pragma omp parallel for
+    for (unsigned int i = 0; i < this->nTuples; ++i) {
+        for (unsigned int j = 0; j < nFeatures; ++j) {
+            float value = rows[(size_t)i * stride + j];
+            size_t position = layout == ROW_MAJOR ? (size_t)i * this->stride + j : (size_t)j * this->stride + i;
+            if (precision == PRECISION_FP32) {
+                this->data[position] = value;
+            } else {
+                this->halfData[position] = narrow(value, precision);
+            }
+        }
+    }
+}
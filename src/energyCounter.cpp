@@ -0,0 +1,157 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file energyCounter.cpp
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Implementation of the RAPL energy counters
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+/********************************* Includes *******************************/
+#include "energyCounter.h"
+
+#include <mpi.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+/******************************** Constants *******************************/
+
+/********************************* Methods ********************************/
+EnergyCounter::EnergyCounter() : startTime(0), currentPhase(-1), nodeLeader(false) {
+    for (unsigned int p = 0; p < N_PHASES; ++p) {
+        this->seconds[p] = this->packageJoules[p] = this->dramJoules[p] = 0;
+    }
+
+    // Processes in the same node share the counters, only the first one reads them
+    MPI_Comm nodeComm;
+    int nodeRank;
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &nodeComm);
+    MPI_Comm_rank(nodeComm, &nodeRank);
+    MPI_Comm_free(&nodeComm);
+    this->nodeLeader = !nodeRank;
+
+    if (this->nodeLeader) {
+        this->discoverDomains();
+    }
+}
+
+void EnergyCounter::discoverDomains() {
+    namespace fs = std::filesystem;
+    std::error_code error;
+
+    if (!fs::is_directory(POWERCAP_PATH, error)) {
+        return;
+    }
+
+    for (const auto& entry : fs::directory_iterator(POWERCAP_PATH, error)) {
+        // Zones are intel-rapl:N (package) and subzones intel-rapl:N:M (core, uncore, dram), also in AMD
+        std::string zone = entry.path().filename().string();
+        if (zone.rfind("intel-rapl:", 0) != 0) {
+            continue;
+        }
+
+        std::string name;
+        unsigned long long maxRange = 0, value = 0;
+        std::ifstream nameFile(entry.path() / "name");
+        std::ifstream rangeFile(entry.path() / "max_energy_range_uj");
+        std::ifstream energyFile(entry.path() / "energy_uj");
+        if (!(nameFile >> name) || !(rangeFile >> maxRange) || !(energyFile >> value)) {
+            continue;
+        }
+
+        if (name.rfind("package", 0) == 0 || name == "dram") {
+            this->domains.push_back({(entry.path() / "energy_uj").string(), name == "dram", maxRange});
+        }
+    }
+}
+
+std::vector<unsigned long long> EnergyCounter::readCounters() const {
+    std::vector<unsigned long long> counters(this->domains.size(), 0);
+    for (unsigned int d = 0; d < this->domains.size(); ++d) {
+        std::ifstream energyFile(this->domains[d].path);
+        energyFile >> counters[d];
+    }
+    return counters;
+}
+
+bool EnergyCounter::isAvailable() const {
+    return !this->domains.empty();
+}
+
+void EnergyCounter::start(Phase phase) {
+    this->currentPhase = phase;
+    this->startCounter = this->readCounters();
+    this->startTime = MPI_Wtime();
+}
+
+void EnergyCounter::stop() {
+    if (this->currentPhase < 0) {
+        return;
+    }
+
+    std::vector<unsigned long long> endCounter = this->readCounters();
+    this->seconds[this->currentPhase] += MPI_Wtime() - this->startTime;
+
+    for (unsigned int d = 0; d < this->domains.size(); ++d) {
+        // The counter wraps around when it reaches max_energy_range_uj
+        unsigned long long delta = (endCounter[d] >= this->startCounter[d])
+                                       ? endCounter[d] - this->startCounter[d]
+                                       : this->domains[d].maxRange - this->startCounter[d] + endCounter[d];
+        if (this->domains[d].isDram) {
+            this->dramJoules[this->currentPhase] += delta * 1e-6;
+        } else {
+            this->packageJoules[this->currentPhase] += delta * 1e-6;
+        }
+    }
+
+    this->currentPhase = -1;
+}
+
+void EnergyCounter::report(std::ostream& os, unsigned long nQueries) {
+    double maxSeconds[N_PHASES], totalPackage[N_PHASES], totalDram[N_PHASES];
+    int available = this->isAvailable(), nodesAvailable = 0, nodes = 0;
+    int leader = this->nodeLeader;
+
+    MPI_Reduce(this->seconds, maxSeconds, N_PHASES, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+    MPI_Reduce(this->packageJoules, totalPackage, N_PHASES, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+    MPI_Reduce(this->dramJoules, totalDram, N_PHASES, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&available, &nodesAvailable, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&leader, &nodes, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+
+    if (MPI::COMM_WORLD.Get_rank()) {
+        return;
+    }
+
+    if (!nodesAvailable) {
+        os << WARNING_RAPL_UNAVAILABLE << std::endl;
+    }
+
+    double sumSeconds = 0, sumPackage = 0, sumDram = 0;
+    os << "Energy report (" << nodesAvailable << "/" << nodes << " nodes with RAPL):" << std::endl;
+    os << std::left << std::setw(24) << "Phase" << std::right << std::setw(12) << "Time (s)" << std::setw(14) << "Package (J)" << std::setw(12) << "DRAM (J)" << std::endl;
+    os << std::fixed << std::setprecision(3);
+    for (unsigned int p = 0; p < N_PHASES; ++p) {
+        os << std::left << std::setw(24) << PHASE_NAMES[p] << std::right << std::setw(12) << maxSeconds[p] << std::setw(14) << totalPackage[p] << std::setw(12) << totalDram[p] << std::endl;
+        sumSeconds += maxSeconds[p];
+        sumPackage += totalPackage[p];
+        sumDram += totalDram[p];
+    }
+    os << std::left << std::setw(24) << "total" << std::right << std::setw(12) << sumSeconds << std::setw(14) << sumPackage << std::setw(12) << sumDram << std::endl;
+
+    if (nQueries && nodesAvailable) {
+        os << "Energy per query: " << std::setprecision(6) << (totalPackage[PHASE_SCORE] + totalDram[PHASE_SCORE]) / nQueries << " J" << std::endl;
+    }
+    os << std::defaultfloat;
+}
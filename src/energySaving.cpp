@@ -20,6 +20,7 @@
 
 #include <mpi.h>
 #include <string.h>
+#include <unistd.h>
 
 #include <chrono>
 #include <ctime>
@@ -32,176 +33,185 @@
 /******************************** Constants *******************************/
 
 /********************************* Methods ********************************/
-int EnergyAwareClientAPI::sendPackage(const char *buffer) {
-    int len = SSL_write(this->ssl, buffer, strlen(buffer));
-    if (len < 0) {
-        int err = SSL_get_error(ssl, len);
-        switch (err) {
-            case SSL_ERROR_WANT_WRITE:
-                return 0;
-            case SSL_ERROR_WANT_READ:
-                return 0;
-            case SSL_ERROR_ZERO_RETURN:
-            case SSL_ERROR_SYSCALL:
-            case SSL_ERROR_SSL:
-            default:
-                return -1;
-        }
-    }
-    return len;
+Energy::Energy(const Config &config) {
+    struct_mapping::reg(&Energy::date, "date");
+    struct_mapping::reg(&Energy::hour, "hour");
+    struct_mapping::reg(&Energy::isCheap, "is-cheap");
+    struct_mapping::reg(&Energy::isUnderAvg, "is-under-avg");
+    struct_mapping::reg(&Energy::market, "market");
+    struct_mapping::reg(&Energy::price, "price");
+    struct_mapping::reg(&Energy::units, "units");
+
+    this->isCheap = this->isUnderAvg = true;
+    this->price = 0;
+    this->client = new HttpClient(config.energyApiHost.c_str(), config.energyApiPort,
+                                  config.energyApiCaFile.empty() ? NULL : config.energyApiCaFile.c_str());
+    this->path = config.energyApiPath;
+    this->epoch = this->appliedEpoch = this->publishedEpoch = 0;
+    this->nextFetch = 0;
+    this->stopped = false;
+
+    // The decisions travel in their own communicator so they never match the messages of the search
+    MPI_Comm_dup(MPI_COMM_WORLD, &this->comm);
+    MPI_Comm_rank(this->comm, &this->rank);
 }
 
-std::string EnergyAwareClientAPI::recvPackage() {
-    int len = 0;
-    std::string allBuffer = "";
-    do {
-        char buf[1];
-        len = SSL_read(this->ssl, buf, 1);
-
-        // Only copy when start in "{" and end in "}"
-        if (allBuffer == "" && buf[0] == '{') {
-            allBuffer += buf[0];
-        } else if (allBuffer != "") {
-            allBuffer += buf[0];
-            if (buf[0] == '}') {
-                break;
-            }
-        }
-    } while (len > 0);
-    return allBuffer;
+Energy::~Energy() {
+    delete this->client;
 }
 
-void EnergyAwareClientAPI::initSSL() {
-    SSL_library_init();
-    OpenSSL_add_all_algorithms();
-    SSL_load_error_strings();
-    const SSL_METHOD *meth = TLSv1_2_client_method();
-    SSL_CTX *ctx = SSL_CTX_new(meth);
-    this->ssl = SSL_new(ctx);
-
-    if (!this->ssl) {
-        perror("Error creating SSL.\n");
-        exit(EXIT_FAILURE);
+bool Energy::fetchEnergyPriceNow() {
+    HttpResponse response = this->client->get(this->path);
+    if (response.status != 200) {
+        fprintf(stderr, "Error fetching the energy price, status %d\n", response.status);
+        return false;
     }
 
-    SSL_get_fd(this->ssl);
-    SSL_set_fd(this->ssl, this->sock);
-    int err = SSL_connect(this->ssl);
-    if (err <= 0) {
-        printf("Error creating SSL connection.  err=%x\n", err);
-        fflush(stdout);
-        exit(EXIT_FAILURE);
+    try {
+        std::istringstream is(response.body);
+        std::lock_guard<std::mutex> guard(this->mutex);
+        struct_mapping::map_json_to_struct(*this, is);
+    } catch (struct_mapping::StructMappingException &e) {
+        fprintf(stderr, "Error parsing the energy price: %s\n", e.what());
+        return false;
     }
-    // printf("SSL connection using %s\n", SSL_get_cipher(ssl));
+    return true;
 }
 
-char *EnergyAwareClientAPI::hostToIp(const char *host) {
-    hostent *hostname = gethostbyname(host);
-    if (hostname) {
-        return inet_ntoa(*(struct in_addr *)hostname->h_addr);
+void Energy::waitUntilInitializeData() {
+    while (!this->epoch) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
-    fprintf(stderr, "ERROR, no such host\n");
-    exit(EXIT_FAILURE);
 }
 
-int EnergyAwareClientAPI::openSocket() {
-    this->sock = socket(AF_INET, SOCK_STREAM, 0);
-    if (this->sock < -1) {
-        perror("Error creating socket.\n");
-        exit(EXIT_FAILURE);
+void Energy::checkEnergyPrice() {
+    while (!this->stopped) {
+        printf("Thread main checking energy price\n");
+        // If the fetch fails the last known price is kept so the cluster is not blocked
+        this->fetchEnergyPriceNow();
+        this->sleepThread();
     }
-    return 0;
 }
 
-int EnergyAwareClientAPI::connectToServer() {
-    this->server.sin_family = AF_INET;
-    this->server.sin_addr.s_addr = inet_addr(this->host);
-    this->server.sin_port = htons(this->port);
-
-    socklen_t socklen = sizeof(this->server);
-    if (connect(this->sock, (struct sockaddr *)&this->server, socklen)) {
-        perror("Error connecting to server.\n");
-        exit(EXIT_FAILURE);
-    }
-    return 0;
-}
+void Energy::sleepThread() {
+    using std::chrono::system_clock;
+    std::time_t tt = system_clock::to_time_t(system_clock::now());
 
-EnergyAwareClientAPI::EnergyAwareClientAPI(const char *host, int port) {
-    this->host = this->hostToIp(host);
-    this->port = port;
+    struct std::tm *ptm = std::localtime(&tt);
 
-    this->openSocket();
-    this->connectToServer();
-    this->initSSL();
+    ++ptm->tm_hour;
+    ptm->tm_min = 0;
+    ptm->tm_sec = 0;
+
+    // The next fetch is known before publishing the epoch, so the pauses end after it
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->nextFetch = mktime(ptm);
+    ++this->epoch;
+    std::cout << "Owner" << this->rank << " - waiting for: " << std::put_time(ptm, "%X") << '\n';
+    this->wakeUp.wait_until(lock, system_clock::from_time_t(this->nextFetch), [this] { return this->stopped.load(); });
 }
 
-void EnergyAwareClientAPI::closeConnection() {
-    SSL_shutdown(this->ssl);
-    SSL_free(this->ssl);
-    close(this->sock);
+void Energy::stop() {
+    {
+        std::lock_guard<std::mutex> guard(this->mutex);
+        this->stopped = true;
+    }
+    this->wakeUp.notify_all();
 }
 
-Energy::Energy() {
-    struct_mapping::reg(&Energy::date, "date");
-    struct_mapping::reg(&Energy::hour, "hour");
-    struct_mapping::reg(&Energy::isCheap, "is-cheap");
-    struct_mapping::reg(&Energy::isUnderAvg, "is-under-avg");
-    struct_mapping::reg(&Energy::market, "market");
-    struct_mapping::reg(&Energy::price, "price");
-    struct_mapping::reg(&Energy::units, "units");
+EnergyDecision Energy::getDecision() {
+    this->waitUntilInitializeData();
 
-    // this->client = new EnergyAwareClientAPI("api.preciodelaluz.org", 443);
+    std::lock_guard<std::mutex> guard(this->mutex);
+    std::time_t now = std::time(NULL);
+    EnergyDecision decision;
+    decision.epoch = this->epoch;
+    decision.pause = !(this->isCheap && this->isUnderAvg);
+    decision.seconds = (this->nextFetch > now ? this->nextFetch - now : 0) + ENERGY_PAUSE_MARGIN;
+    return decision;
 }
 
-Energy::~Energy() {}
+void Energy::applyDecision(const EnergyDecision &decision) {
+    // Each decision pauses once, after the pause the process waits for a newer epoch
+    if (decision.epoch <= this->appliedEpoch) {
+        return;
+    }
+    this->appliedEpoch = decision.epoch;
 
-void Energy::fetchEnergyPriceNow() {
-    this->client = new EnergyAwareClientAPI("api.preciodelaluz.org", 443);
-    std::string request = "GET /v1/prices/now?zone=PCB HTTP/1.1\r\nHost: api.preciodelaluz.org\r\nConnection: close\r\n\r\n";
-    this->client->sendPackage(request.c_str());
-    std::istringstream is(this->client->recvPackage());
-    struct_mapping::map_json_to_struct(*this, is);
-    this->client->closeConnection();
+    if (decision.pause) {
+        printf("Process %d pausing %u seconds by energy decision %u\n", this->rank, decision.seconds, decision.epoch);
+        std::this_thread::sleep_for(std::chrono::seconds(decision.seconds));
+    }
 }
 
-void Energy::waitUntilInitializeData() {
-    while (this->date == "")
-        ;
-    sleep(1);
+void Energy::syncDecision() {
+    EnergyDecision decision;
+    if (this->rank == ENERGY_OWNER_RANK) {
+        decision = this->getDecision();
+    }
+    MPI_Bcast(&decision, 3, MPI_UNSIGNED, ENERGY_OWNER_RANK, this->comm);
+    this->applyDecision(decision);
 }
 
-void Energy::checkSleep() {
-    // Print value date with printf
-    this->waitUntilInitializeData();
-    // printf("Thread slave: Date: %s\n", date.c_str());
-    // std::cout << *this << std::endl;
-    // std::cout << (!(this->isCheap && this->isUnderAvg) ? "cara" : "barata") << std::endl;
-    if (!(this->isCheap && this->isUnderAvg)) {
-        this->sleepThread(true);
+void Energy::publishDecision() {
+    EnergyDecision decision = this->getDecision();
+    if (decision.epoch == this->publishedEpoch) {
+        return;
     }
-}
+    this->publishedEpoch = decision.epoch;
 
-void Energy::checkEnergyPrice() {
-    while (true) {
-        this->date = "";
-        printf("Thread main checking energy price\n");
-        this->fetchEnergyPriceNow();
-        sleepThread();
+    int size;
+    MPI_Comm_size(this->comm, &size);
+    for (int r = 0; r < size; ++r) {
+        if (r != ENERGY_OWNER_RANK) {
+            MPI_Send(&decision, 3, MPI_UNSIGNED, r, TAG_ENERGY_DECISION, this->comm);
+        }
     }
 }
 
-void Energy::sleepThread(bool isSlave) {
-    using std::chrono::system_clock;
-    std::time_t tt = system_clock::to_time_t(system_clock::now());
-    std::string name = isSlave ? "Slave" : "Master";
+void Energy::checkSleep() {
+    EnergyDecision decision, newest;
+    newest.epoch = 0;
 
-    struct std::tm *ptm = std::localtime(&tt);
+    // Until the first decision arrives the slave does not know if it can run
+    if (!this->appliedEpoch) {
+        MPI_Recv(&newest, 3, MPI_UNSIGNED, ENERGY_OWNER_RANK, TAG_ENERGY_DECISION, this->comm, MPI_STATUS_IGNORE);
+    }
 
-    ++ptm->tm_hour;
-    ptm->tm_min = 0;
-    ptm->tm_sec = isSlave ? 5 : 0;
-    std::cout << name << MPI::COMM_WORLD.Get_rank() << "/" << MPI::COMM_WORLD.Get_size() << " - current time: " << std::put_time(ptm, "%X") << " - waiting for: " << std::put_time(ptm, "%X") << '\n';
-    std::this_thread::sleep_until(system_clock::from_time_t(mktime(ptm)));
+    int pending = 1;
+    while (pending) {
+        MPI_Iprobe(ENERGY_OWNER_RANK, TAG_ENERGY_DECISION, this->comm, &pending, MPI_STATUS_IGNORE);
+        if (pending) {
+            MPI_Recv(&decision, 3, MPI_UNSIGNED, ENERGY_OWNER_RANK, TAG_ENERGY_DECISION, this->comm, MPI_STATUS_IGNORE);
+            if (decision.epoch > newest.epoch) {
+                newest = decision;
+            }
+        }
+    }
+
+    if (newest.epoch) {
+        this->applyDecision(newest);
+    }
+}
+
+void Energy::endDecisions() {
+    EnergyDecision decision;
+    if (this->rank == ENERGY_OWNER_RANK) {
+        decision.epoch = ENERGY_LAST_EPOCH;
+        decision.pause = decision.seconds = 0;
+
+        int size;
+        MPI_Comm_size(this->comm, &size);
+        for (int r = 0; r < size; ++r) {
+            if (r != ENERGY_OWNER_RANK) {
+                MPI_Send(&decision, 3, MPI_UNSIGNED, r, TAG_ENERGY_DECISION, this->comm);
+            }
+        }
+    } else {
+        do {
+            MPI_Recv(&decision, 3, MPI_UNSIGNED, ENERGY_OWNER_RANK, TAG_ENERGY_DECISION, this->comm, MPI_STATUS_IGNORE);
+        } while (decision.epoch != ENERGY_LAST_EPOCH);
+    }
 }
 
 std::ostream &operator<<(std::ostream &os, const Energy &o) {
@@ -0,0 +1,152 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file featureSweep.cpp
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Implementation of the incremental sweep over the number of features
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+/********************************* Includes *******************************/
+#include "featureSweep.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+#include "knn.h"
+#include "radixSelect.h"
+
+/******************************** Constants *******************************/
+
+/********************************* Methods ********************************/
+bool FeatureSweep::supports(float (*distanceFunction)(std::vector<float>&,
+                                                      std::vector<float>&,
+                                                      unsigned int,
+                                                      unsigned int,
+                                                      unsigned int)) {
+    return distanceFunction == euclideanDistance || distanceFunction == manhattanDistance;
+}
+
+FeatureSweep::FeatureSweep(std::vector<float>& dataTraining,
+                           std::vector<float>& dataTest,
+                           std::vector<unsigned int>& labelsTraining,
+                           float (*distanceFunction)(std::vector<float>&,
+                                                     std::vector<float>&,
+                                                     unsigned int,
+                                                     unsigned int,
+                                                     unsigned int),
+                           unsigned int maxFeatures,
+                           const Config& config,
+                           DataPrecision precision)
+    : training(dataTraining, config.nFeatures, maxFeatures, COLUMN_MAJOR, precision, getHugePages(config.hugePages)),
+      test(dataTest, config.nFeatures, maxFeatures, COLUMN_MAJOR, precision, getHugePages(config.hugePages)),
+      labelsTraining(labelsTraining),
+      squared(distanceFunction == euclideanDistance),
+      sums((size_t)test.getNTuples() * training.getStride(), 0, AlignedAllocator<float>(getHugePages(config.hugePages))),
+      nFeatures(0) {}
+
+void FeatureSweep::addTerms(float* sums, const float* values, float value, unsigned int n) const {
+    if (this->squared) {
+        // The square in double is exact, the same value as pow in euclideanDistance
+        for (unsigned int j = 0; j < n; ++j) {
+            double difference = values[j] - value;
+            sums[j] = sums[j] + difference * difference;
+        }
+    } else {
+        for (unsigned int j = 0; j < n; ++j) {
+            sums[j] += std::fabs(values[j] - value);
+        }
+    }
+}
+
+void FeatureSweep::addFeatures(unsigned int nFeatures) {
+    // The padding of the columns is also added, so the loops have no remainder
+    unsigned int stride = this->training.getStride();
+    unsigned int nTest = this->test.getNTuples();
+    DataPrecision precision = this->training.getPrecision();
+    void (*widenBlock)(const uint16_t*, float*) = getWidenBlock(precision);
+
+    // The sums of a test tuple stay in cache while all its new features are added
+#pragma omp parallel for schedule(static)
+    for (unsigned int i = 0; i < nTest; ++i) {
+        float* sums = (float*)__builtin_assume_aligned(&this->sums[(size_t)i * stride], MEMORY_ALIGNMENT);
+        for (unsigned int f = this->nFeatures; f < nFeatures; ++f) {
+            float value = this->test.get(i, f);
+            if (precision == PRECISION_FP32) {
+                this->addTerms(sums, (const float*)__builtin_assume_aligned(this->training.getColumn(f), MEMORY_ALIGNMENT), value, stride);
+                continue;
+            }
+
+            // The values are widened in registers, the stride is a multiple of WIDEN_BLOCK
+            const uint16_t* column = this->training.getHalfColumn(f);
+            for (unsigned int j = 0; j < stride; j += WIDEN_BLOCK) {
+                float values[WIDEN_BLOCK];
+                widenBlock(column + j, values);
+                this->addTerms(sums + j, values, value, WIDEN_BLOCK);
+            }
+        }
+    }
+
+    this->nFeatures = std::max(this->nFeatures, nFeatures);
+}
+
+std::vector<unsigned int> FeatureSweep::getAccuracies(unsigned int nFeatures,
+                                                      unsigned short minValueK,
+                                                      unsigned short maxValueK,
+                                                      std::vector<unsigned int>& labelsTest) {
+    this->addFeatures(nFeatures);
+
+    unsigned int nTraining = this->training.getNTuples();
+    unsigned int stride = this->training.getStride();
+    unsigned int nTest = this->test.getNTuples();
+    unsigned int lastK = std::min((unsigned int)maxValueK, nTraining);
+    std::vector<unsigned int> vectorAccuracies(maxValueK - minValueK + 1, 0);
+
+#pragma omp parallel
+    {
+        // Each thread counts its hits apart and they are added at the end
+        std::vector<unsigned int> localAccuracies(vectorAccuracies.size(), 0);
+        std::vector<uint64_t> keys, scratch;
+#pragma omp for schedule(dynamic)
+        for (unsigned int i = 0; i < nTest; ++i) {
+            // Only the lastK nearest are needed, the position in the keys keeps the ties in the order of the training data
+            const float* sums = &this->sums[(size_t)i * stride];
+            keys.resize(nTraining);
+            for (unsigned int j = 0; j < nTraining; ++j) {
+                keys[j] = getDistanceKey(this->squared ? (float)sqrt(sums[j]) : sums[j], j);
+            }
+            selectSmallestKeys(keys, lastK, scratch);
+
+            // The class of getMostFrequentClass for every k in one pass, each k extends the previous one
+            std::map<unsigned int, int> counters;
+            unsigned int mostFrequentClass = this->labelsTraining[getKeyPosition(keys[0])];
+            int maxCounter = 0;
+            for (unsigned int k = 1; k <= lastK; ++k) {
+                unsigned int label = this->labelsTraining[getKeyPosition(keys[k - 1])];
+                if (++counters[label] > maxCounter) {
+                    maxCounter = counters[label];
+                    mostFrequentClass = label;
+                }
+                if (k >= minValueK && mostFrequentClass == labelsTest[i]) {
+                    localAccuracies[k - minValueK]++;
+                }
+            }
+        }
+#pragma omp critical
+        for (unsigned int i = 0; i < vectorAccuracies.size(); ++i) {
+            vectorAccuracies[i] += localAccuracies[i];
+        }
+    }
+
+    return vectorAccuracies;
+}
@@ -0,0 +1,77 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file halfFloat.cpp
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Implementation of the widening of FP16 and BF16 blocks with the SIMD of the CPU
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+
+/********************************* Includes *******************************/
+#include "halfFloat.h"
+
+#include <immintrin.h>
+
+/******************************** Constants *******************************/
+
+/********************************* Methods ********************************/
+
+/**
+ * @brief Widen WIDEN_BLOCK FP16 values one by one
+ * @param values The bits of the values
+ * @param floats Where the floats are stored
+ */
+static void widenHalfScalar(const uint16_t* values, float* floats) {
+    for (unsigned int i = 0; i < WIDEN_BLOCK; ++i) {
+        floats[i] = halfToFloat(values[i]);
+    }
+}
+
+/**
+ * @brief Widen WIDEN_BLOCK FP16 values with F16C, 8 at once
+ * @param values The bits of the values
+ * @param floats Where the floats are stored
+ */
+__attribute__((target("avx,f16c"))) static void widenHalfF16C(const uint16_t* values, float* floats) {
+    for (unsigned int i = 0; i < WIDEN_BLOCK; i += 8) {
+        _mm256_storeu_ps(floats + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(values + i))));
+    }
+}
+
+/**
+ * @brief Widen WIDEN_BLOCK BF16 values one by one, a shift that the compiler may vectorize
+ * @param values The bits of the values
+ * @param floats Where the floats are stored
+ */
+static void widenBFloat16Scalar(const uint16_t* values, float* floats) {
+    for (unsigned int i = 0; i < WIDEN_BLOCK; ++i) {
+        floats[i] = bfloat16ToFloat(values[i]);
+    }
+}
+
+/**
+ * @brief Widen WIDEN_BLOCK BF16 values with AVX-512 BF16, the 16 at once
+ * @param values The bits of the values
+ * @param floats Where the floats are stored
+ */
+__attribute__((target("avx512f,avx512bf16"))) static void widenBFloat16AVX512(const uint16_t* values, float* floats) {
+    _mm512_storeu_ps(floats, _mm512_cvtpbh_ps((__m256bh)_mm256_loadu_si256((const __m256i*)values)));
+}
+
+void (*getWidenBlock(DataPrecision precision))(const uint16_t*, float*) {
+    static_assert(WIDEN_BLOCK == 16, "The SIMD kernels widen 16 values");
+    if (precision == PRECISION_FP16) {
+        return __builtin_cpu_supports("f16c") ? widenHalfF16C : widenHalfScalar;
+    }
+    return __builtin_cpu_supports("avx512bf16") ? widenBFloat16AVX512 : widenBFloat16Scalar;
+}
@@ -0,0 +1,158 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file hammingFilter.cpp
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Implementation of the prefilter of the training data by the Hamming distance of binary codes
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+/********************************* Includes *******************************/
+#include "hammingFilter.h"
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <queue>
+
+/******************************** Constants *******************************/
+
+/********************************* Methods ********************************/
+
+/**
+ * @brief Get the Hamming distance between two codes
+ * @param a The first code
+ * @param b The second code
+ * @param n The number of words
+ * @return The number of bits that differ
+ */
+static uint32_t hammingDistanceScalar(const uint64_t* a, const uint64_t* b, unsigned int n) {
+    uint32_t distance = 0;
+    for (unsigned int i = 0; i < n; ++i) {
+        distance += __builtin_popcountll(a[i] ^ b[i]);
+    }
+    return distance;
+}
+
+/**
+ * @brief Get the Hamming distance between two codes with the popcnt instruction
+ * @param a The first code
+ * @param b The second code
+ * @param n The number of words
+ * @return The number of bits that differ
+ */
+__attribute__((target("popcnt"))) static uint32_t hammingDistancePopcnt(const uint64_t* a, const uint64_t* b, unsigned int n) {
+    uint32_t distance = 0;
+    for (unsigned int i = 0; i < n; ++i) {
+        distance += _mm_popcnt_u64(a[i] ^ b[i]);
+    }
+    return distance;
+}
+
+/**
+ * @brief Get the Hamming distance between two codes with AVX-512 VPOPCNTDQ, 8 words at once
+ * @param a The first code, aligned
+ * @param b The second code, aligned
+ * @param n The number of words, a multiple of HAMMING_BLOCK_WORDS
+ * @return The number of bits that differ
+ */
+__attribute__((target("avx512f,avx512vpopcntdq"))) static uint32_t hammingDistanceVPOPCNTDQ(const uint64_t* a, const uint64_t* b, unsigned int n) {
+    __m512i sum = _mm512_setzero_si512();
+    for (unsigned int i = 0; i < n; i += HAMMING_BLOCK_WORDS) {
+        sum = _mm512_add_epi64(sum, _mm512_popcnt_epi64(_mm512_xor_si512(_mm512_load_si512(a + i), _mm512_load_si512(b + i))));
+    }
+    return _mm512_reduce_add_epi64(sum);
+}
+
+HammingFilter::HammingFilter(std::vector<float>& dataTraining,
+                             std::vector<unsigned int>& labelsTraining,
+                             float (*distanceFunction)(std::vector<float>&,
+                                                       std::vector<float>&,
+                                                       unsigned int,
+                                                       unsigned int,
+                                                       unsigned int),
+                             unsigned int nFeatures,
+                             const Config& config)
+    : NeighborIndex(labelsTraining),
+      dataTraining(dataTraining),
+      distanceFunction(distanceFunction),
+      nFeatures(nFeatures),
+      stride(config.nFeatures),
+      nWords((nFeatures + HAMMING_WORD_BITS * HAMMING_BLOCK_WORDS - 1) / (HAMMING_WORD_BITS * HAMMING_BLOCK_WORDS) * HAMMING_BLOCK_WORDS),
+      nCandidates(config.hammingCandidates),
+      medians(nFeatures, 0) {
+    unsigned int nTuples = dataTraining.size() / config.nFeatures;
+
+#pragma omp parallel for
+    for (unsigned int f = 0; f < nFeatures; ++f) {
+        std::vector<float> values(nTuples);
+        for (unsigned int i = 0; i < nTuples; ++i) {
+            values[i] = dataTraining[i * this->stride + f];
+        }
+        if (nTuples) {
+            std::nth_element(values.begin(), values.begin() + nTuples / 2, values.end());
+            this->medians[f] = values[nTuples / 2];
+        }
+    }
+
+    this->codes.assign((size_t)nTuples * this->nWords, 0);
+#pragma omp parallel for
+    for (unsigned int i = 0; i < nTuples; ++i) {
+        this->binarize(dataTraining, i * this->stride, &this->codes[(size_t)i * this->nWords]);
+    }
+
+    this->kernel = __builtin_cpu_supports("avx512vpopcntdq") ? hammingDistanceVPOPCNTDQ
+                   : __builtin_cpu_supports("popcnt")         ? hammingDistancePopcnt
+                                                              : hammingDistanceScalar;
+}
+
+void HammingFilter::binarize(const std::vector<float>& data, unsigned int ptrData, uint64_t* code) const {
+    for (unsigned int f = 0; f < this->nFeatures; ++f) {
+        if (data[ptrData + f] > this->medians[f]) {
+            code[f / HAMMING_WORD_BITS] |= 1ULL << (f % HAMMING_WORD_BITS);
+        }
+    }
+}
+
+std::vector<std::pair<float, unsigned int>> HammingFilter::getNearestTuples(std::vector<float>& dataTest, unsigned int ptrDataTest, unsigned int k) const {
+    unsigned int nTuples = this->labelsTraining.size();
+    std::vector<uint64_t, AlignedAllocator<uint64_t>> query(this->nWords, 0);
+    this->binarize(dataTest, ptrDataTest, query.data());
+
+    // The nearest candidates by the Hamming distance, the ties in the order of the training data
+    unsigned int nCandidates = std::max(k, this->nCandidates);
+    std::priority_queue<std::pair<uint32_t, unsigned int>> heap;
+    for (unsigned int i = 0; i < nTuples; ++i) {
+        std::pair<uint32_t, unsigned int> candidate(this->kernel(&this->codes[(size_t)i * this->nWords], query.data(), this->nWords), i);
+        if (heap.size() < nCandidates) {
+            heap.push(candidate);
+        } else if (candidate < heap.top()) {
+            heap.pop();
+            heap.push(candidate);
+        }
+    }
+
+    std::vector<std::pair<float, unsigned int>> neighbors;
+    neighbors.reserve(heap.size());
+    while (!heap.empty()) {
+        unsigned int i = heap.top().second;
+        neighbors.push_back(std::make_pair(this->distanceFunction(this->dataTraining, dataTest, i * this->stride, ptrDataTest, this->nFeatures), i));
+        heap.pop();
+    }
+
+    std::sort(neighbors.begin(), neighbors.end());
+    if (neighbors.size() > k) {
+        neighbors.resize(k);
+    }
+
+    return neighbors;
+}
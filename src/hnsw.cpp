@@ -0,0 +1,210 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file hnsw.cpp
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Implementation of the Hierarchical Navigable Small World graph
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+/********************************* Includes *******************************/
+#include "hnsw.h"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <random>
+
+/******************************** Constants *******************************/
+
+/********************************* Methods ********************************/
+HNSW::HNSW(std::vector<float>& dataTraining,
+           std::vector<unsigned int>& labelsTraining,
+           float (*distanceFunction)(std::vector<float>&,
+                                     std::vector<float>&,
+                                     unsigned int,
+                                     unsigned int,
+                                     unsigned int),
+           unsigned int nFeatures,
+           const Config& config)
+    : NeighborIndex(labelsTraining),
+      distanceFunction(distanceFunction),
+      nFeatures(nFeatures),
+      M(std::max(2U, config.hnswM)),
+      efConstruction(std::max(1U, config.hnswEfConstruction)),
+      efSearch(std::max(1U, config.hnswEfSearch)),
+      entryPoint(0),
+      maxLevel(-1) {
+    unsigned int nTuples = dataTraining.size() / config.nFeatures;
+    this->points.resize((size_t)nTuples * nFeatures);
+    for (unsigned int i = 0; i < nTuples; ++i) {
+        std::copy_n(dataTraining.begin() + (size_t)i * config.nFeatures, nFeatures, this->points.begin() + (size_t)i * nFeatures);
+    }
+
+    // The number of tuples of each level decreases exponentially by a factor M
+    std::mt19937 generator(HNSW_SEED);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    double levelFactor = 1 / std::log((double)this->M);
+
+    this->links.resize(nTuples);
+    for (unsigned int i = 0; i < nTuples; ++i) {
+        this->insert(i, (int)std::floor(-std::log(1.0 - uniform(generator)) * levelFactor));
+    }
+}
+
+std::vector<std::pair<float, unsigned int>> HNSW::searchLevel(std::vector<float>& dataQuery, unsigned int ptrDataQuery, const std::vector<std::pair<float, unsigned int>>& entryPoints, unsigned int ef, int level) const {
+    // Candidates to expand, the nearest first, and nearest tuples found, the farthest on top
+    std::priority_queue<std::pair<float, unsigned int>, std::vector<std::pair<float, unsigned int>>, std::greater<std::pair<float, unsigned int>>> candidates;
+    std::priority_queue<std::pair<float, unsigned int>> nearest;
+
+    // The tuples visited are marked with the number of the search, so the marks are never cleared
+    static thread_local std::vector<unsigned int> visited;
+    static thread_local unsigned int search = 0;
+    if (visited.size() < this->links.size() || ++search == 0) {
+        visited.assign(std::max(visited.size(), this->links.size()), 0);
+        search = 1;
+    }
+
+    for (const auto& entry : entryPoints) {
+        visited[entry.second] = search;
+        candidates.push(entry);
+        nearest.push(entry);
+    }
+    while (nearest.size() > ef) {
+        nearest.pop();
+    }
+
+    while (!candidates.empty()) {
+        std::pair<float, unsigned int> current = candidates.top();
+        if (current.first > nearest.top().first && nearest.size() >= ef) {
+            break;
+        }
+        candidates.pop();
+
+        for (unsigned int neighbor : this->links[current.second][level]) {
+            if (visited[neighbor] == search) {
+                continue;
+            }
+            visited[neighbor] = search;
+            std::pair<float, unsigned int> candidate(this->distanceFunction(this->points, dataQuery, neighbor * this->nFeatures, ptrDataQuery, this->nFeatures), neighbor);
+            if (nearest.size() < ef || candidate < nearest.top()) {
+                candidates.push(candidate);
+                nearest.push(candidate);
+                if (nearest.size() > ef) {
+                    nearest.pop();
+                }
+            }
+        }
+    }
+
+    std::vector<std::pair<float, unsigned int>> result(nearest.size());
+    for (auto it = result.rbegin(); it != result.rend(); ++it) {
+        *it = nearest.top();
+        nearest.pop();
+    }
+
+    return result;
+}
+
+std::vector<unsigned int> HNSW::selectLinks(const std::vector<std::pair<float, unsigned int>>& candidates, unsigned int maxLinks) const {
+    std::vector<unsigned int> selected;
+
+    for (const auto& candidate : candidates) {
+        if (selected.size() >= maxLinks) {
+            break;
+        }
+        bool diverse = true;
+        for (unsigned int link : selected) {
+            if (this->distanceFunction(this->points, this->points, link * this->nFeatures, candidate.second * this->nFeatures, this->nFeatures) < candidate.first) {
+                diverse = false;
+                break;
+            }
+        }
+        if (diverse) {
+            selected.push_back(candidate.second);
+        }
+    }
+
+    // The free links are filled with the nearest candidates skipped
+    for (const auto& candidate : candidates) {
+        if (selected.size() >= maxLinks) {
+            break;
+        }
+        if (std::find(selected.begin(), selected.end(), candidate.second) == selected.end()) {
+            selected.push_back(candidate.second);
+        }
+    }
+
+    return selected;
+}
+
+void HNSW::insert(unsigned int tuple, int level) {
+    this->links[tuple].resize(level + 1);
+    if (this->maxLevel < 0) {
+        this->entryPoint = tuple;
+        this->maxLevel = level;
+        return;
+    }
+
+    unsigned int ptrTuple = tuple * this->nFeatures;
+    std::vector<std::pair<float, unsigned int>> entryPoints{std::make_pair(this->distanceFunction(this->points, this->points, this->entryPoint * this->nFeatures, ptrTuple, this->nFeatures), this->entryPoint)};
+
+    // Descend greedily through the levels above the tuple
+    for (int l = this->maxLevel; l > level; --l) {
+        entryPoints = this->searchLevel(this->points, ptrTuple, entryPoints, 1, l);
+    }
+
+    for (int l = std::min(level, this->maxLevel); l >= 0; --l) {
+        std::vector<std::pair<float, unsigned int>> candidates = this->searchLevel(this->points, ptrTuple, entryPoints, this->efConstruction, l);
+        unsigned int maxLinks = l ? this->M : 2 * this->M;
+        this->links[tuple][l] = this->selectLinks(candidates, this->M);
+
+        // Link back, a neighbor with too many links keeps the best ones
+        for (unsigned int neighbor : this->links[tuple][l]) {
+            std::vector<unsigned int>& neighborLinks = this->links[neighbor][l];
+            neighborLinks.push_back(tuple);
+            if (neighborLinks.size() > maxLinks) {
+                std::vector<std::pair<float, unsigned int>> neighborCandidates;
+                for (unsigned int link : neighborLinks) {
+                    neighborCandidates.push_back(std::make_pair(this->distanceFunction(this->points, this->points, neighbor * this->nFeatures, link * this->nFeatures, this->nFeatures), link));
+                }
+                std::sort(neighborCandidates.begin(), neighborCandidates.end());
+                neighborLinks = this->selectLinks(neighborCandidates, maxLinks);
+            }
+        }
+        entryPoints = candidates;
+    }
+
+    if (level > this->maxLevel) {
+        this->entryPoint = tuple;
+        this->maxLevel = level;
+    }
+}
+
+std::vector<std::pair<float, unsigned int>> HNSW::getNearestTuples(std::vector<float>& dataTest, unsigned int ptrDataTest, unsigned int k) const {
+    std::vector<std::pair<float, unsigned int>> neighbors;
+    if (this->maxLevel < 0 || !k) {
+        return neighbors;
+    }
+
+    std::vector<std::pair<float, unsigned int>> entryPoints{std::make_pair(this->distanceFunction(this->points, dataTest, this->entryPoint * this->nFeatures, ptrDataTest, this->nFeatures), this->entryPoint)};
+    for (int l = this->maxLevel; l > 0; --l) {
+        entryPoints = this->searchLevel(dataTest, ptrDataTest, entryPoints, 1, l);
+    }
+    entryPoints = this->searchLevel(dataTest, ptrDataTest, entryPoints, std::max(this->efSearch, k), 0);
+
+    for (unsigned int i = 0; i < std::min((size_t)k, entryPoints.size()); ++i) {
+        neighbors.push_back(entryPoints[i]);
+    }
+
+    return neighbors;
+}
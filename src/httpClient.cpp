@@ -0,0 +1,316 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file httpClient.cpp
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Implementation of the HTTP/1.1 over TLS client
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+/********************************* Includes *******************************/
+#include "httpClient.h"
+
+#include <errno.h>
+#include <netdb.h>
+#include <signal.h>
+#include <openssl/err.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+/******************************** Constants *******************************/
+
+/********************************* Methods ********************************/
+
+/**
+ * @brief Copy of a string in lowercase, the header names and some values are case-insensitive
+ * @param value The string
+ * @return std::string in lowercase
+ */
+static std::string toLower(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+    return value;
+}
+
+HttpClient::HttpClient(const char *host, int port, const char *caFile)
+    : host(host), port(port), ssl(NULL), sock(-1), bufferBegin(0), bufferEnd(0) {
+    SSL_library_init();
+    SSL_load_error_strings();
+
+    // Writing to a connection closed by the server must not kill the process
+    signal(SIGPIPE, SIG_IGN);
+
+    this->ctx = SSL_CTX_new(TLS_client_method());
+    if (!this->ctx) {
+        perror("Error creating SSL context.\n");
+        exit(EXIT_FAILURE);
+    }
+    SSL_CTX_set_min_proto_version(this->ctx, TLS1_2_VERSION);
+
+    // The server is always verified, against caFile or the certificates of the system
+    int loaded = caFile ? SSL_CTX_load_verify_locations(this->ctx, caFile, NULL) : SSL_CTX_set_default_verify_paths(this->ctx);
+    if (loaded != 1) {
+        fprintf(stderr, "Error loading the certificates %s\n", caFile ? caFile : "of the system");
+        ERR_print_errors_fp(stderr);
+        exit(EXIT_FAILURE);
+    }
+    SSL_CTX_set_verify(this->ctx, SSL_VERIFY_PEER, NULL);
+}
+
+HttpClient::~HttpClient() {
+    this->closeConnection();
+    SSL_CTX_free(this->ctx);
+}
+
+bool HttpClient::connectToServer() {
+    struct addrinfo hints, *result;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    if (getaddrinfo(this->host.c_str(), std::to_string(this->port).c_str(), &hints, &result)) {
+        fprintf(stderr, "ERROR, no such host %s\n", this->host.c_str());
+        return false;
+    }
+
+    // A server that stalls makes the request fail instead of blocking the thread, in Linux the
+    // send timeout also bounds connect
+    struct timeval timeout;
+    timeout.tv_sec = HTTP_TIMEOUT_SECONDS;
+    timeout.tv_usec = 0;
+
+    for (struct addrinfo *addr = result; addr && this->sock < 0; addr = addr->ai_next) {
+        this->sock = socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+        if (this->sock >= 0 && (setsockopt(this->sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) ||
+                                setsockopt(this->sock, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout)) ||
+                                connect(this->sock, addr->ai_addr, addr->ai_addrlen))) {
+            close(this->sock);
+            this->sock = -1;
+        }
+    }
+    freeaddrinfo(result);
+
+    if (this->sock < 0) {
+        perror("Error connecting to server.\n");
+        return false;
+    }
+
+    // The certificate must be issued to the host, and SNI selects it in shared servers
+    this->ssl = SSL_new(this->ctx);
+    if (!this->ssl || !SSL_set_fd(this->ssl, this->sock) || !SSL_set1_host(this->ssl, this->host.c_str()) ||
+        !SSL_set_tlsext_host_name(this->ssl, this->host.c_str()) || SSL_connect(this->ssl) <= 0) {
+        fprintf(stderr, "Error creating SSL connection with %s\n", this->host.c_str());
+        ERR_print_errors_fp(stderr);
+        this->closeConnection();
+        return false;
+    }
+
+    this->bufferBegin = this->bufferEnd = 0;
+    return true;
+}
+
+bool HttpClient::isAlive() {
+    if (!this->ssl) {
+        return false;
+    }
+
+    // An idle keep-alive connection has nothing to read, if it is readable the server closed it
+    char byte;
+    ssize_t len = recv(this->sock, &byte, 1, MSG_PEEK | MSG_DONTWAIT);
+    return len < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+}
+
+void HttpClient::closeConnection() {
+    if (this->ssl) {
+        SSL_shutdown(this->ssl);
+        SSL_free(this->ssl);
+        this->ssl = NULL;
+    }
+    if (this->sock >= 0) {
+        close(this->sock);
+        this->sock = -1;
+    }
+    this->bufferBegin = this->bufferEnd = 0;
+}
+
+bool HttpClient::fillBuffer() {
+    // Move the data not consumed to the beginning to make room
+    if (this->bufferBegin > 0) {
+        memmove(this->buffer, this->buffer + this->bufferBegin, this->bufferEnd - this->bufferBegin);
+        this->bufferEnd -= this->bufferBegin;
+        this->bufferBegin = 0;
+    }
+
+    int len = SSL_read(this->ssl, this->buffer + this->bufferEnd, HTTP_BUFFER_SIZE - this->bufferEnd);
+    if (len <= 0) {
+        return false;
+    }
+
+    this->bufferEnd += len;
+    return true;
+}
+
+bool HttpClient::readLine(std::string &line) {
+    line.clear();
+    while (true) {
+        char *begin = this->buffer + this->bufferBegin;
+        char *end = this->buffer + this->bufferEnd;
+        char *newLine = std::find(begin, end, '\n');
+
+        if (newLine != end) {
+            line.append(begin, newLine);
+            this->bufferBegin += newLine - begin + 1;
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            return true;
+        }
+
+        // Line longer than the buffer, keep what has been read
+        line.append(begin, end);
+        this->bufferBegin = this->bufferEnd = 0;
+        if (!this->fillBuffer()) {
+            return false;
+        }
+    }
+}
+
+bool HttpClient::readBytes(unsigned long n, std::string &out) {
+    while (n > 0) {
+        if (this->bufferBegin == this->bufferEnd) {
+            this->bufferBegin = this->bufferEnd = 0;
+            if (!this->fillBuffer()) {
+                return false;
+            }
+        }
+
+        unsigned long len = std::min(n, (unsigned long)(this->bufferEnd - this->bufferBegin));
+        out.append(this->buffer + this->bufferBegin, len);
+        this->bufferBegin += len;
+        n -= len;
+    }
+    return true;
+}
+
+bool HttpClient::writeAll(const std::string &data) {
+    unsigned long written = 0;
+    while (written < data.size()) {
+        int len = SSL_write(this->ssl, data.c_str() + written, data.size() - written);
+        if (len <= 0) {
+            return false;
+        }
+        written += len;
+    }
+    return true;
+}
+
+bool HttpClient::readResponse(HttpResponse &response) {
+    std::string line;
+
+    // Status line: HTTP/1.1 200 OK
+    if (!this->readLine(line) || line.compare(0, 5, "HTTP/") || line.find(' ') == std::string::npos) {
+        return false;
+    }
+    response.status = atoi(line.c_str() + line.find(' ') + 1);
+
+    // Headers until an empty line
+    while (true) {
+        if (!this->readLine(line)) {
+            return false;
+        }
+        if (line.empty()) {
+            break;
+        }
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) {
+            continue;
+        }
+        std::string name = toLower(line.substr(0, colon));
+        size_t valueBegin = line.find_first_not_of(" \t", colon + 1);
+        response.headers[name] = (valueBegin == std::string::npos) ? "" : line.substr(valueBegin);
+    }
+
+    // Body framed by chunked encoding, Content-Length or the end of the connection
+    auto transferEncoding = response.headers.find("transfer-encoding");
+    auto contentLength = response.headers.find("content-length");
+    if (transferEncoding != response.headers.end() && toLower(transferEncoding->second).find("chunked") != std::string::npos) {
+        while (true) {
+            if (!this->readLine(line)) {
+                return false;
+            }
+            unsigned long chunkSize = strtoul(line.c_str(), NULL, 16);
+            if (!chunkSize) {
+                break;
+            }
+            if (!this->readBytes(chunkSize, response.body) || !this->readLine(line)) {
+                return false;
+            }
+        }
+        // Trailers until an empty line
+        while (this->readLine(line) && !line.empty())
+            ;
+    } else if (contentLength != response.headers.end()) {
+        if (!this->readBytes(strtoul(contentLength->second.c_str(), NULL, 10), response.body)) {
+            return false;
+        }
+    } else {
+        response.body.append(this->buffer + this->bufferBegin, this->bufferEnd - this->bufferBegin);
+        this->bufferBegin = this->bufferEnd = 0;
+        while (this->fillBuffer()) {
+            response.body.append(this->buffer, this->bufferEnd);
+            this->bufferEnd = 0;
+        }
+        this->closeConnection();
+    }
+
+    auto connection = response.headers.find("connection");
+    if (connection != response.headers.end() && toLower(connection->second) == "close") {
+        this->closeConnection();
+    }
+    return true;
+}
+
+HttpResponse HttpClient::get(const std::string &path) {
+    HttpResponse response;
+    std::string request = "GET " + path + " HTTP/1.1\r\nHost: " + this->host + "\r\nConnection: keep-alive\r\n\r\n";
+
+    // If the reused connection fails the request is retried once with a new connection
+    for (unsigned int attempt = 0; attempt < 2; ++attempt) {
+        response.status = -1;
+        response.headers.clear();
+        response.body.clear();
+
+        bool reused = this->isAlive();
+        if (!reused) {
+            this->closeConnection();
+            if (!this->connectToServer()) {
+                return response;
+            }
+        }
+
+        if (this->writeAll(request) && this->readResponse(response)) {
+            return response;
+        }
+
+        this->closeConnection();
+        response.status = -1;
+        if (!reused) {
+            break;
+        }
+    }
+
+    return response;
+}
@@ -0,0 +1,231 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file ivfpq.cpp
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Implementation of the inverted file index with product quantization
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+/********************************* Includes *******************************/
+#include "ivfpq.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <numeric>
+#include <queue>
+#include <random>
+
+/******************************** Constants *******************************/
+
+/********************************* Methods ********************************/
+IVFPQ::IVFPQ(std::vector<float>& dataTraining,
+             std::vector<unsigned int>& labelsTraining,
+             float (*distanceFunction)(std::vector<float>&,
+                                       std::vector<float>&,
+                                       unsigned int,
+                                       unsigned int,
+                                       unsigned int),
+             unsigned int nFeatures,
+             const Config& config)
+    : NeighborIndex(labelsTraining),
+      dataTraining(config.ivfRerank ? &dataTraining : NULL),
+      distanceFunction(distanceFunction),
+      nFeatures(nFeatures),
+      stride(config.nFeatures),
+      nRerank(config.ivfRerank) {
+    unsigned int nTuples = dataTraining.size() / config.nFeatures;
+    unsigned int nLists = config.ivfLists ? config.ivfLists : (unsigned int)std::lround(std::sqrt((double)nTuples));
+    nLists = std::max(1U, std::min(nLists, nTuples));
+    unsigned int nSubspaces = std::max(1U, std::min(config.pqSubspaces, nFeatures));
+    this->nProbe = std::max(1U, std::min(config.ivfProbe, nLists));
+    this->nCodes = std::max(1U, std::min(PQ_CENTROIDS, nTuples));
+
+    // The editing of Wilson can leave no training tuple, the lists stay empty
+    if (!nTuples) {
+        return;
+    }
+
+    std::vector<float> data((size_t)nTuples * nFeatures);
+    for (unsigned int i = 0; i < nTuples; ++i) {
+        std::copy_n(dataTraining.begin() + (size_t)i * config.nFeatures, nFeatures, data.begin() + (size_t)i * nFeatures);
+    }
+
+    // Coarse quantizer, each tuple goes to the list of its nearest centroid
+    this->coarseCentroids = kmeans(data, nTuples, nFeatures, nLists);
+    std::vector<unsigned int> assignment(nTuples);
+#pragma omp parallel for
+    for (unsigned int i = 0; i < nTuples; ++i) {
+        assignment[i] = nearestCentroid(&data[(size_t)i * nFeatures], this->coarseCentroids.data(), nLists, nFeatures);
+        for (unsigned int f = 0; f < nFeatures; ++f) {
+            data[(size_t)i * nFeatures + f] -= this->coarseCentroids[(size_t)assignment[i] * nFeatures + f];
+        }
+    }
+
+    // The residuals are split in groups of consecutive features, each one with its own codebook
+    this->subspaces.resize(nSubspaces + 1);
+    for (unsigned int g = 0; g <= nSubspaces; ++g) {
+        this->subspaces[g] = (unsigned long)g * nFeatures / nSubspaces;
+    }
+    this->codebooks.resize((size_t)PQ_CENTROIDS * nFeatures);
+    std::vector<uint8_t> codes((size_t)nTuples * nSubspaces);
+    for (unsigned int g = 0; g < nSubspaces; ++g) {
+        unsigned int dimension = this->subspaces[g + 1] - this->subspaces[g];
+        std::vector<float> subvectors((size_t)nTuples * dimension);
+        for (unsigned int i = 0; i < nTuples; ++i) {
+            std::copy_n(data.begin() + (size_t)i * nFeatures + this->subspaces[g], dimension, subvectors.begin() + (size_t)i * dimension);
+        }
+        std::vector<float> centroids = kmeans(subvectors, nTuples, dimension, this->nCodes);
+        float* codebook = &this->codebooks[(size_t)PQ_CENTROIDS * this->subspaces[g]];
+        std::copy(centroids.begin(), centroids.end(), codebook);
+#pragma omp parallel for
+        for (unsigned int i = 0; i < nTuples; ++i) {
+            codes[(size_t)i * nSubspaces + g] = nearestCentroid(&subvectors[(size_t)i * dimension], codebook, this->nCodes, dimension);
+        }
+    }
+
+    this->listTuples.resize(nLists);
+    this->listCodes.resize(nLists);
+    for (unsigned int i = 0; i < nTuples; ++i) {
+        this->listTuples[assignment[i]].push_back(i);
+        this->listCodes[assignment[i]].insert(this->listCodes[assignment[i]].end(), codes.begin() + (size_t)i * nSubspaces, codes.begin() + (size_t)(i + 1) * nSubspaces);
+    }
+}
+
+bool IVFPQ::usesTrainingData() const {
+    return this->dataTraining;
+}
+
+float IVFPQ::squaredDistance(const float* a, const float* b, unsigned int n) {
+    float distance = 0;
+    for (unsigned int i = 0; i < n; ++i) {
+        distance += (a[i] - b[i]) * (a[i] - b[i]);
+    }
+    return distance;
+}
+
+unsigned int IVFPQ::nearestCentroid(const float* vector, const float* centroids, unsigned int nCentroids, unsigned int dimension) {
+    unsigned int nearest = 0;
+    float minDistance = FLT_MAX;
+    for (unsigned int c = 0; c < nCentroids; ++c) {
+        float distance = squaredDistance(vector, centroids + (size_t)c * dimension, dimension);
+        if (distance < minDistance) {
+            minDistance = distance;
+            nearest = c;
+        }
+    }
+    return nearest;
+}
+
+std::vector<float> IVFPQ::kmeans(const std::vector<float>& data, unsigned int nVectors, unsigned int dimension, unsigned int nCentroids) {
+    // The initial centroids are different vectors chosen at random
+    std::vector<unsigned int> order(nVectors);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), std::mt19937(KMEANS_SEED));
+    std::vector<float> centroids((size_t)nCentroids * dimension);
+    for (unsigned int c = 0; c < nCentroids; ++c) {
+        std::copy_n(data.begin() + (size_t)order[c] * dimension, dimension, centroids.begin() + (size_t)c * dimension);
+    }
+
+    std::vector<unsigned int> assignment(nVectors);
+    for (unsigned int iteration = 0; iteration < KMEANS_ITERATIONS; ++iteration) {
+#pragma omp parallel for
+        for (unsigned int i = 0; i < nVectors; ++i) {
+            assignment[i] = nearestCentroid(&data[(size_t)i * dimension], centroids.data(), nCentroids, dimension);
+        }
+
+        // An empty cluster keeps its centroid
+        std::vector<double> sums((size_t)nCentroids * dimension, 0);
+        std::vector<unsigned int> counts(nCentroids, 0);
+        for (unsigned int i = 0; i < nVectors; ++i) {
+            counts[assignment[i]]++;
+            for (unsigned int d = 0; d < dimension; ++d) {
+                sums[(size_t)assignment[i] * dimension + d] += data[(size_t)i * dimension + d];
+            }
+        }
+        for (unsigned int c = 0; c < nCentroids; ++c) {
+            for (unsigned int d = 0; counts[c] && d < dimension; ++d) {
+                centroids[(size_t)c * dimension + d] = sums[(size_t)c * dimension + d] / counts[c];
+            }
+        }
+    }
+
+    return centroids;
+}
+
+std::vector<std::pair<float, unsigned int>> IVFPQ::getNearestTuples(std::vector<float>& dataTest, unsigned int ptrDataTest, unsigned int k) const {
+    if (this->listTuples.empty()) {
+        return std::vector<std::pair<float, unsigned int>>();
+    }
+
+    const float* query = &dataTest[ptrDataTest];
+    unsigned int nLists = this->listTuples.size();
+    unsigned int nSubspaces = this->subspaces.size() - 1;
+    unsigned int nCandidates = std::max(k, this->nRerank);
+
+    // The nearest lists to the query
+    std::vector<std::pair<float, unsigned int>> lists(nLists);
+    for (unsigned int l = 0; l < nLists; ++l) {
+        lists[l] = std::make_pair(squaredDistance(query, &this->coarseCentroids[(size_t)l * this->nFeatures], this->nFeatures), l);
+    }
+    std::partial_sort(lists.begin(), lists.begin() + this->nProbe, lists.end());
+
+    std::priority_queue<std::pair<float, unsigned int>> heap;
+    std::vector<float> residual(this->nFeatures), table((size_t)nSubspaces * PQ_CENTROIDS);
+    for (unsigned int p = 0; p < this->nProbe; ++p) {
+        unsigned int list = lists[p].second;
+        for (unsigned int f = 0; f < this->nFeatures; ++f) {
+            residual[f] = query[f] - this->coarseCentroids[(size_t)list * this->nFeatures + f];
+        }
+
+        // Distance from the residual of the query to each centroid of each group
+        for (unsigned int g = 0; g < nSubspaces; ++g) {
+            unsigned int dimension = this->subspaces[g + 1] - this->subspaces[g];
+            const float* codebook = &this->codebooks[(size_t)PQ_CENTROIDS * this->subspaces[g]];
+            for (unsigned int c = 0; c < this->nCodes; ++c) {
+                table[(size_t)g * PQ_CENTROIDS + c] = squaredDistance(&residual[this->subspaces[g]], codebook + (size_t)c * dimension, dimension);
+            }
+        }
+
+        const std::vector<unsigned int>& tuples = this->listTuples[list];
+        const uint8_t* codes = this->listCodes[list].data();
+        for (unsigned int i = 0; i < tuples.size(); ++i) {
+            float distance = 0;
+            for (unsigned int g = 0; g < nSubspaces; ++g) {
+                distance += table[(size_t)g * PQ_CENTROIDS + codes[(size_t)i * nSubspaces + g]];
+            }
+            std::pair<float, unsigned int> candidate(distance, tuples[i]);
+            if (heap.size() < nCandidates) {
+                heap.push(candidate);
+            } else if (candidate < heap.top()) {
+                heap.pop();
+                heap.push(candidate);
+            }
+        }
+    }
+
+    std::vector<std::pair<float, unsigned int>> candidates;
+    for (; !heap.empty(); heap.pop()) {
+        unsigned int tuple = heap.top().second;
+        float distance = this->nRerank ? this->distanceFunction(*this->dataTraining, dataTest, tuple * this->stride, ptrDataTest, this->nFeatures) : std::sqrt(heap.top().first);
+        candidates.push_back(std::make_pair(distance, tuple));
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    std::vector<std::pair<float, unsigned int>> neighbors;
+    for (unsigned int i = 0; i < std::min((size_t)k, candidates.size()); ++i) {
+        neighbors.push_back(candidates[i]);
+    }
+
+    return neighbors;
+}
@@ -0,0 +1,135 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file kdTree.cpp
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Implementation of the kd-tree
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+/********************************* Includes *******************************/
+#include "kdTree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+/******************************** Constants *******************************/
+
+/********************************* Methods ********************************/
+KDTree::KDTree(std::vector<float>& dataTraining,
+               std::vector<unsigned int>& labelsTraining,
+               float (*distanceFunction)(std::vector<float>&,
+                                         std::vector<float>&,
+                                         unsigned int,
+                                         unsigned int,
+                                         unsigned int),
+               unsigned int nFeatures,
+               const Config& config)
+    : NeighborIndex(labelsTraining), distanceFunction(distanceFunction), nFeatures(nFeatures) {
+    unsigned int nTuples = dataTraining.size() / config.nFeatures;
+    this->indexes.resize(nTuples);
+    std::iota(this->indexes.begin(), this->indexes.end(), 0);
+    if (nTuples) {
+        this->build(dataTraining, 0, nTuples, config);
+    }
+
+    // The tuples of each leaf are contiguous so the search reads them in order
+    this->points.resize((size_t)nTuples * nFeatures);
+    for (unsigned int i = 0; i < nTuples; ++i) {
+        std::copy_n(dataTraining.begin() + (size_t)this->indexes[i] * config.nFeatures, nFeatures, this->points.begin() + (size_t)i * nFeatures);
+    }
+}
+
+unsigned int KDTree::build(std::vector<float>& dataTraining, unsigned int begin, unsigned int end, const Config& config) {
+    unsigned int node = this->nodes.size();
+    this->nodes.push_back(Node{begin, end, -1, 0, 0, 0});
+    if (end - begin <= KDTREE_LEAF_SIZE) {
+        return node;
+    }
+
+    // Split by the feature with the largest spread
+    int splitFeature = -1;
+    float maxSpread = 0;
+    for (unsigned int f = 0; f < this->nFeatures; ++f) {
+        float minValue = dataTraining[(size_t)this->indexes[begin] * config.nFeatures + f], maxValue = minValue;
+        for (unsigned int i = begin + 1; i < end; ++i) {
+            float value = dataTraining[(size_t)this->indexes[i] * config.nFeatures + f];
+            minValue = std::min(minValue, value);
+            maxValue = std::max(maxValue, value);
+        }
+        if (maxValue - minValue > maxSpread) {
+            maxSpread = maxValue - minValue;
+            splitFeature = f;
+        }
+    }
+
+    // All the tuples are equal, nothing to split
+    if (splitFeature < 0) {
+        return node;
+    }
+
+    unsigned int middle = begin + (end - begin) / 2;
+    std::nth_element(this->indexes.begin() + begin, this->indexes.begin() + middle, this->indexes.begin() + end, [&](unsigned int a, unsigned int b) {
+        return dataTraining[(size_t)a * config.nFeatures + splitFeature] < dataTraining[(size_t)b * config.nFeatures + splitFeature];
+    });
+
+    // The children reorder their tuples, so the median is read before building them
+    float splitValue = dataTraining[(size_t)this->indexes[middle] * config.nFeatures + splitFeature];
+    unsigned int left = this->build(dataTraining, begin, middle, config);
+    unsigned int right = this->build(dataTraining, middle, end, config);
+    this->nodes[node].splitFeature = splitFeature;
+    this->nodes[node].splitValue = splitValue;
+    this->nodes[node].left = left;
+    this->nodes[node].right = right;
+
+    return node;
+}
+
+void KDTree::search(unsigned int node, std::vector<float>& dataTest, unsigned int ptrDataTest, unsigned int k, std::priority_queue<std::pair<float, unsigned int>>& heap) const {
+    const Node& current = this->nodes[node];
+
+    if (current.splitFeature < 0) {
+        for (unsigned int i = current.begin; i < current.end; ++i) {
+            std::pair<float, unsigned int> candidate(this->distanceFunction(this->points, dataTest, i * this->nFeatures, ptrDataTest, this->nFeatures), this->indexes[i]);
+            if (heap.size() < k) {
+                heap.push(candidate);
+            } else if (candidate < heap.top()) {
+                heap.pop();
+                heap.push(candidate);
+            }
+        }
+        return;
+    }
+
+    // First the side of the query, the other one only if it can have a nearer tuple
+    float difference = dataTest[ptrDataTest + current.splitFeature] - current.splitValue;
+    this->search(difference < 0 ? current.left : current.right, dataTest, ptrDataTest, k, heap);
+    if (heap.size() < k || std::fabs(difference) <= heap.top().first * (1 + KDTREE_PRUNE_SLACK)) {
+        this->search(difference < 0 ? current.right : current.left, dataTest, ptrDataTest, k, heap);
+    }
+}
+
+std::vector<std::pair<float, unsigned int>> KDTree::getNearestTuples(std::vector<float>& dataTest, unsigned int ptrDataTest, unsigned int k) const {
+    std::priority_queue<std::pair<float, unsigned int>> heap;
+    if (!this->nodes.empty() && k) {
+        this->search(0, dataTest, ptrDataTest, k, heap);
+    }
+
+    std::vector<std::pair<float, unsigned int>> neighbors(heap.size());
+    for (auto it = neighbors.rbegin(); it != neighbors.rend(); ++it) {
+        *it = heap.top();
+        heap.pop();
+    }
+
+    return neighbors;
+}
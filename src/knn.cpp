@@ -27,12 +27,348 @@
 #include <cstring>
 #include <iostream>
 
+#include <memory>
+#include <queue>
+
+#include <unistd.h>
+
+#include "alignedAllocator.h"
+#include "checkpoint.h"
+#include "featureSweep.h"
+#include "numaPlacement.h"
+#include "radixSelect.h"
+
 /******************************** Constants *******************************/
 
 /********************************* Methods ********************************/
+
+/**
+ * @brief euclideanDistance for N features, known when it is compiled so the loop is unrolled
+ * without remainder. The terms are added in the same order, so the value is the same
+ * @param dataTraining The reference to training data
+ * @param dataTest The reference to data test
+ * @param ptrDataTraining The pointer to the training tuple
+ * @param ptrDataTest The pointer to the test tuple
+ * @param nFeatures Unused, it is N
+ * @return float with the distance
+ */
+template <unsigned int N>
+static float euclideanDistanceFixed(std::vector<float>& dataTraining,
+                                    std::vector<float>& dataTest,
+                                    unsigned int ptrDataTraining,
+                                    unsigned int ptrDataTest,
+                                    [[maybe_unused]] unsigned int nFeatures) {
+    const float* training = dataTraining.data() + ptrDataTraining;
+    const float* test = dataTest.data() + ptrDataTest;
+    float distance = 0;
+
+    // The square in double is exact, the same value as pow in euclideanDistance
+    for (unsigned int i = 0; i < N; ++i) {
+        double difference = training[i] - test[i];
+        distance += difference * difference;
+    }
+
+    return sqrt(distance);
+}
+
+/**
+ * @brief manhattanDistance for N features, known when it is compiled so the loop is unrolled
+ * without remainder. The terms are added in the same order, so the value is the same
+ * @param dataTraining The reference to training data
+ * @param dataTest The reference to data test
+ * @param ptrDataTraining The pointer to the training tuple
+ * @param ptrDataTest The pointer to the test tuple
+ * @param nFeatures Unused, it is N
+ * @return float with the distance
+ */
+template <unsigned int N>
+static float manhattanDistanceFixed(std::vector<float>& dataTraining,
+                                    std::vector<float>& dataTest,
+                                    unsigned int ptrDataTraining,
+                                    unsigned int ptrDataTest,
+                                    [[maybe_unused]] unsigned int nFeatures) {
+    const float* training = dataTraining.data() + ptrDataTraining;
+    const float* test = dataTest.data() + ptrDataTest;
+    float distance = 0;
+
+    for (unsigned int i = 0; i < N; ++i) {
+        distance += std::fabs(training[i] - test[i]);
+    }
+
+    return distance;
+}
+
+/**
+ * @brief euclideanDistanceBounded for N features, a multiple of DISTANCE_ABANDON_BLOCK, so every
+ * block is full and unrolled
+ * @param dataTraining The reference to training data
+ * @param dataTest The reference to data test
+ * @param ptrDataTraining The pointer to the training tuple
+ * @param ptrDataTest The pointer to the test tuple
+ * @param nFeatures Unused, it is N
+ * @param bound The distance over which the tuple is abandoned
+ * @return float with the same value as euclideanDistanceFixed, or INFINITY if it is larger than bound
+ */
+template <unsigned int N>
+static float euclideanDistanceBoundedFixed(std::vector<float>& dataTraining,
+                                           std::vector<float>& dataTest,
+                                           unsigned int ptrDataTraining,
+                                           unsigned int ptrDataTest,
+                                           [[maybe_unused]] unsigned int nFeatures,
+                                           float bound) {
+    const float* training = dataTraining.data() + ptrDataTraining;
+    const float* test = dataTest.data() + ptrDataTest;
+    float distance = 0;
+
+    double boundSquared = (double)bound * bound;
+    for (unsigned int block = 0; block < N; block += DISTANCE_ABANDON_BLOCK) {
+        for (unsigned int i = block; i < block + DISTANCE_ABANDON_BLOCK; ++i) {
+            double difference = training[i] - test[i];
+            distance += difference * difference;
+        }
+        if (distance > boundSquared) {
+            return INFINITY;
+        }
+    }
+
+    return sqrt(distance);
+}
+
+/**
+ * @brief manhattanDistanceBounded for N features, a multiple of DISTANCE_ABANDON_BLOCK, so every
+ * block is full and unrolled
+ * @param dataTraining The reference to training data
+ * @param dataTest The reference to data test
+ * @param ptrDataTraining The pointer to the training tuple
+ * @param ptrDataTest The pointer to the test tuple
+ * @param nFeatures Unused, it is N
+ * @param bound The distance over which the tuple is abandoned
+ * @return float with the same value as manhattanDistanceFixed, or INFINITY if it is larger than bound
+ */
+template <unsigned int N>
+static float manhattanDistanceBoundedFixed(std::vector<float>& dataTraining,
+                                           std::vector<float>& dataTest,
+                                           unsigned int ptrDataTraining,
+                                           unsigned int ptrDataTest,
+                                           [[maybe_unused]] unsigned int nFeatures,
+                                           float bound) {
+    const float* training = dataTraining.data() + ptrDataTraining;
+    const float* test = dataTest.data() + ptrDataTest;
+    float distance = 0;
+
+    for (unsigned int block = 0; block < N; block += DISTANCE_ABANDON_BLOCK) {
+        for (unsigned int i = block; i < block + DISTANCE_ABANDON_BLOCK; ++i) {
+            distance += std::fabs(training[i] - test[i]);
+        }
+        if (distance > bound) {
+            return INFINITY;
+        }
+    }
+
+    return distance;
+}
+
+/**
+ * Kernels of a fixed number of features, the one of n features at n / DISTANCE_ABANDON_BLOCK - 1
+ */
+static float (*const euclideanDistancesFixed[])(std::vector<float>&, std::vector<float>&, unsigned int, unsigned int, unsigned int) = {
+    euclideanDistanceFixed<8>, euclideanDistanceFixed<16>, euclideanDistanceFixed<24>, euclideanDistanceFixed<32>,
+    euclideanDistanceFixed<40>, euclideanDistanceFixed<48>, euclideanDistanceFixed<56>, euclideanDistanceFixed<64>};
+static float (*const manhattanDistancesFixed[])(std::vector<float>&, std::vector<float>&, unsigned int, unsigned int, unsigned int) = {
+    manhattanDistanceFixed<8>, manhattanDistanceFixed<16>, manhattanDistanceFixed<24>, manhattanDistanceFixed<32>,
+    manhattanDistanceFixed<40>, manhattanDistanceFixed<48>, manhattanDistanceFixed<56>, manhattanDistanceFixed<64>};
+static float (*const euclideanDistancesBoundedFixed[])(std::vector<float>&, std::vector<float>&, unsigned int, unsigned int, unsigned int, float) = {
+    euclideanDistanceBoundedFixed<8>, euclideanDistanceBoundedFixed<16>, euclideanDistanceBoundedFixed<24>, euclideanDistanceBoundedFixed<32>,
+    euclideanDistanceBoundedFixed<40>, euclideanDistanceBoundedFixed<48>, euclideanDistanceBoundedFixed<56>, euclideanDistanceBoundedFixed<64>};
+static float (*const manhattanDistancesBoundedFixed[])(std::vector<float>&, std::vector<float>&, unsigned int, unsigned int, unsigned int, float) = {
+    manhattanDistanceBoundedFixed<8>, manhattanDistanceBoundedFixed<16>, manhattanDistanceBoundedFixed<24>, manhattanDistanceBoundedFixed<32>,
+    manhattanDistanceBoundedFixed<40>, manhattanDistanceBoundedFixed<48>, manhattanDistanceBoundedFixed<56>, manhattanDistanceBoundedFixed<64>};
+
+/**
+ * @brief Check if there is a kernel of a fixed number of features
+ * @param nFeatures The number of features
+ * @return true if nFeatures is a multiple of DISTANCE_ABANDON_BLOCK up to DISTANCE_FIXED_MAX
+ */
+static bool hasFixedDistance(unsigned int nFeatures) {
+    return nFeatures > 0 && nFeatures <= DISTANCE_FIXED_MAX && nFeatures % DISTANCE_ABANDON_BLOCK == 0;
+}
+
+/**
+ * @brief Get the kernel of a distance function for a number of features
+ * @param distanceFunction The distance function
+ * @param nFeatures The number of features to use in the distance function
+ * @return The kernel of nFeatures if there is one, the distance function if not
+ */
+static float (*getFixedDistanceFunction(float (*distanceFunction)(std::vector<float>&,
+                                                                   std::vector<float>&,
+                                                                   unsigned int,
+                                                                   unsigned int,
+                                                                   unsigned int),
+                                        unsigned int nFeatures))(std::vector<float>&,
+                                                                 std::vector<float>&,
+                                                                 unsigned int,
+                                                                 unsigned int,
+                                                                 unsigned int) {
+    if (hasFixedDistance(nFeatures) && distanceFunction == euclideanDistance) {
+        return euclideanDistancesFixed[nFeatures / DISTANCE_ABANDON_BLOCK - 1];
+    }
+    if (hasFixedDistance(nFeatures) && distanceFunction == manhattanDistance) {
+        return manhattanDistancesFixed[nFeatures / DISTANCE_ABANDON_BLOCK - 1];
+    }
+
+    return distanceFunction;
+}
+
+/**
+ * @brief Get the early abandoning version of a distance function, the kernel of nFeatures if there is one
+ * @param distanceFunction The distance function
+ * @param nFeatures The number of features to use in the distance function
+ * @return The version with a bound, NULL if the distance function has not got one
+ */
+static float (*getBoundedDistanceFunction(float (*distanceFunction)(std::vector<float>&,
+                                                                     std::vector<float>&,
+                                                                     unsigned int,
+                                                                     unsigned int,
+                                                                     unsigned int),
+                                          unsigned int nFeatures))(std::vector<float>&,
+                                                                   std::vector<float>&,
+                                                                   unsigned int,
+                                                                   unsigned int,
+                                                                   unsigned int,
+                                                                   float) {
+    if (distanceFunction == euclideanDistance) {
+        return hasFixedDistance(nFeatures) ? euclideanDistancesBoundedFixed[nFeatures / DISTANCE_ABANDON_BLOCK - 1] : euclideanDistanceBounded;
+    }
+    if (distanceFunction == manhattanDistance) {
+        return hasFixedDistance(nFeatures) ? manhattanDistancesBoundedFixed[nFeatures / DISTANCE_ABANDON_BLOCK - 1] : manhattanDistanceBounded;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Get the training tuples of a tile of the scan, half of the L2 cache so that it stays
+ * there while the test tuples of a group are compared with it
+ * @param nFeatures The number of features read from each training tuple
+ * @return The number of training tuples of a tile, at least one
+ */
+static unsigned int getScanTileTuples(unsigned int nFeatures) {
+    long cacheSize = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    size_t tileBytes = (cacheSize > 0 ? (size_t)cacheSize : SCAN_TILE_BYTES) / 2;
+    return std::max((size_t)1, tileBytes / (nFeatures * sizeof(float) + MEMORY_ALIGNMENT));
+}
+
+/**
+ * @brief Compute the keys of getDistanceKey of the training tuples of a range, prefetching the
+ * tuple that is config.prefetchDistance ahead
+ * @param keys The keys of all the training tuples, the ones of the range are written
+ * @param first The position of the first training tuple of the range
+ * @param last The position after the last training tuple of the range
+ * @param dataTraining The training data
+ * @param dataTest The test data
+ * @param distanceFunction The distance function to use
+ * @param ptrDataTest The pointer to data test, where use to select one test tuple
+ * @param nFeatures The number of features to use in the distance function
+ * @param prefetch If the tuples must be prefetched, only the first pass over a tile needs it
+ * @param config The configuration of the algorithm
+ */
+static void addDistanceKeys(uint64_t* keys,
+                            unsigned int first,
+                            unsigned int last,
+                            std::vector<float>& dataTraining,
+                            std::vector<float>& dataTest,
+                            float (*distanceFunction)(std::vector<float>&,
+                                                      std::vector<float>&,
+                                                      unsigned int,
+                                                      unsigned int,
+                                                      unsigned int),
+                            unsigned int ptrDataTest,
+                            unsigned int nFeatures,
+                            bool prefetch,
+                            const Config& config) {
+    unsigned int nTuples = dataTraining.size() / config.nFeatures;
+    for (unsigned int i = first; i < last; ++i) {
+        unsigned int ahead = i + config.prefetchDistance;
+        if (prefetch && config.prefetchDistance && ahead < nTuples) {
+            const float* tuple = dataTraining.data() + (size_t)ahead * config.nFeatures;
+            for (unsigned int j = 0; j < nFeatures; j += MEMORY_ALIGNMENT / sizeof(float)) {
+                __builtin_prefetch(tuple + j, 0, 3);
+            }
+        }
+        keys[i] = getDistanceKey(distanceFunction(dataTraining, dataTest, i * config.nFeatures, ptrDataTest, nFeatures), i);
+    }
+}
+
+/**
+ * @brief Add the training tuples of a range to the k nearest to a test tuple found until now
+ * @param heap The k nearest found, pairs of distance and position with the farthest on top
+ * @param k The number of neighbors to find
+ * @param first The position of the first training tuple of the range
+ * @param last The position after the last training tuple of the range, ranges must be added in order
+ * @param dataTraining The training data
+ * @param dataTest The test data
+ * @param distanceFunction The distance function to use
+ * @param boundedDistanceFunction Its early abandoning version, NULL to compute every distance
+ * @param ptrDataTest The pointer to data test, where use to select one test tuple
+ * @param nFeatures The number of features to use in the distance function
+ * @param config The configuration of the algorithm
+ */
+static void addNearestTuples(std::priority_queue<std::pair<float, unsigned int>>& heap,
+                             unsigned int k,
+                             unsigned int first,
+                             unsigned int last,
+                             std::vector<float>& dataTraining,
+                             std::vector<float>& dataTest,
+                             float (*distanceFunction)(std::vector<float>&,
+                                                       std::vector<float>&,
+                                                       unsigned int,
+                                                       unsigned int,
+                                                       unsigned int),
+                             float (*boundedDistanceFunction)(std::vector<float>&,
+                                                              std::vector<float>&,
+                                                              unsigned int,
+                                                              unsigned int,
+                                                              unsigned int,
+                                                              float),
+                             unsigned int ptrDataTest,
+                             unsigned int nFeatures,
+                             const Config& config) {
+    for (unsigned int i = first; i < last; ++i) {
+        if (heap.size() < k) {
+            heap.push(std::make_pair(distanceFunction(dataTraining, dataTest, i * config.nFeatures, ptrDataTest, nFeatures), i));
+            continue;
+        }
+
+        // The tuples come in order, so one at the same distance as the k-th is not nearer, as in the stable sort
+        float bound = heap.top().first;
+        float distance = boundedDistanceFunction ? boundedDistanceFunction(dataTraining, dataTest, i * config.nFeatures, ptrDataTest, nFeatures, bound)
+                                                 : distanceFunction(dataTraining, dataTest, i * config.nFeatures, ptrDataTest, nFeatures);
+        if (distance < bound) {
+            heap.pop();
+            heap.push(std::make_pair(distance, i));
+        }
+    }
+}
+
+/**
+ * @brief Empty the k nearest found into a vector
+ * @param heap The k nearest, pairs of distance and position with the farthest on top
+ * @param labelsTraining The labels of the training data
+ * @return vector with the pairs of distance and label, sorted by distance
+ */
+static std::vector<std::pair<float, unsigned int>> popNearestDistances(std::priority_queue<std::pair<float, unsigned int>>& heap,
+                                                                       std::vector<unsigned int>& labelsTraining) {
+    std::vector<std::pair<float, unsigned int>> distances(heap.size());
+    for (auto it = distances.rbegin(); it != distances.rend(); ++it) {
+        *it = std::make_pair(heap.top().first, labelsTraining[heap.top().second]);
+        heap.pop();
+    }
+
+    return distances;
+}
+
 std::vector<std::pair<float, unsigned int>> getDistances(std::vector<float>& dataTraining,
                                                          std::vector<float>& dataTestTuple,
-                                                         std::vector<unsigned int> labelsTraining,
+                                                         std::vector<unsigned int>& labelsTraining,
                                                          float (*distanceFunction)(std::vector<float>&,
                                                                                    std::vector<float>&,
                                                                                    unsigned int,
@@ -41,28 +377,52 @@ std::vector<std::pair<float, unsigned int>> getDistances(std::vector<float>& dat
                                                          unsigned int ptrDataTest,
                                                          unsigned int nFeatures,
                                                          const Config& config) {
-    std::vector<std::pair<float, unsigned int>> distances;
-
+    // The position in the keys puts the ties in the order of the training data like in the indexes
     unsigned int nTuples = dataTraining.size() / config.nFeatures;
+    std::vector<uint64_t> keys(nTuples), scratch;
+    addDistanceKeys(keys.data(), 0, nTuples, dataTraining, dataTestTuple, getFixedDistanceFunction(distanceFunction, nFeatures), ptrDataTest, nFeatures, true, config);
+    selectSmallestKeys(keys, nTuples, scratch);
+
+    std::vector<std::pair<float, unsigned int>> distances(nTuples);
     for (unsigned int i = 0; i < nTuples; ++i) {
-        float distance = distanceFunction(dataTraining, dataTestTuple, i * config.nFeatures, ptrDataTest, nFeatures);
-        distances.push_back(std::make_pair(distance, labelsTraining[i]));
+        distances[i] = std::make_pair(getKeyDistance(keys[i]), labelsTraining[getKeyPosition(keys[i])]);
     }
 
-    sort(distances.begin(), distances.end(), [](const std::pair<float, unsigned int>& a, const std::pair<float, unsigned int>& b) {
-        return a.first < b.first;
-    });
-
     return distances;
 }
 
+std::vector<std::pair<float, unsigned int>> getNearestDistances(int k,
+                                                                std::vector<float>& dataTraining,
+                                                                std::vector<float>& dataTestTuple,
+                                                                std::vector<unsigned int>& labelsTraining,
+                                                                float (*distanceFunction)(std::vector<float>&,
+                                                                                          std::vector<float>&,
+                                                                                          unsigned int,
+                                                                                          unsigned int,
+                                                                                          unsigned int),
+                                                                unsigned int ptrDataTest,
+                                                                unsigned int nFeatures,
+                                                                const Config& config) {
+    std::priority_queue<std::pair<float, unsigned int>> heap;
+    unsigned int nTuples = dataTraining.size() / config.nFeatures;
+    addNearestTuples(heap, k, 0, nTuples, getNumaLocalData(dataTraining), dataTestTuple, getFixedDistanceFunction(distanceFunction, nFeatures), getBoundedDistanceFunction(distanceFunction, nFeatures), ptrDataTest, nFeatures, config);
+
+    return popNearestDistances(heap, labelsTraining);
+}
+
 unsigned int getMostFrequentClass(int k, std::vector<std::pair<float, unsigned int>>& distances) {
-    std::map<unsigned int, int, std::greater<int>> counters;
+    // On a tie, the class that reaches the maximum first wins, it has the nearer neighbors
+    std::map<unsigned int, int> counters;
+    unsigned int mostFrequentClass = distances.begin()->second;
+    int maxCounter = 0;
     for (auto it = distances.begin(); it != distances.begin() + k; ++it) {
-        counters[it->second]++;
+        if (++counters[it->second] > maxCounter) {
+            maxCounter = counters[it->second];
+            mostFrequentClass = it->second;
+        }
     }
 
-    return counters.begin()->first;
+    return mostFrequentClass;
 }
 
 unsigned int KNN(int k,
@@ -76,9 +436,132 @@ unsigned int KNN(int k,
                                            unsigned int),
                  unsigned int ptrDataTest,
                  unsigned int nFeatures,
-                 const Config& config) {
-    std::vector<std::pair<float, unsigned int>> distances = getDistances(dataTraining, dataTest, labelsTraining, distanceFunction, ptrDataTest, nFeatures, config);
-    return getMostFrequentClass(k, distances);
+                 const Config& config,
+                 const NeighborIndex* index) {
+    std::vector<std::pair<float, unsigned int>> distances = index ? index->getNeighbors(dataTest, ptrDataTest, k) : getNearestDistances(k, dataTraining, dataTest, labelsTraining, distanceFunction, ptrDataTest, nFeatures, config);
+    return getMostFrequentClass(std::min((size_t)k, distances.size()), distances);
+}
+
+std::vector<unsigned int> KNNBatch(int k,
+                                   std::vector<float>& dataTraining,
+                                   std::vector<unsigned int>& labelsTraining,
+                                   float (*distanceFunction)(std::vector<float>&,
+                                                             std::vector<float>&,
+                                                             unsigned int,
+                                                             unsigned int,
+                                                             unsigned int),
+                                   std::vector<float>& queries,
+                                   unsigned int nQueries,
+                                   unsigned int nFeatures,
+                                   const Config& config,
+                                   const NeighborIndex* index) {
+    std::vector<unsigned int> labelsPredicted(nQueries);
+    if (index) {
+#pragma omp parallel for schedule(dynamic)
+        for (unsigned int q = 0; q < nQueries; ++q) {
+            labelsPredicted[q] = KNN(k, dataTraining, queries, labelsTraining, distanceFunction, q * nFeatures, nFeatures, config, index);
+        }
+        return labelsPredicted;
+    }
+
+    unsigned int nTuples = dataTraining.size() / config.nFeatures;
+    float (*boundedDistanceFunction)(std::vector<float>&,
+                                     std::vector<float>&,
+                                     unsigned int,
+                                     unsigned int,
+                                     unsigned int,
+                                     float) = getBoundedDistanceFunction(distanceFunction, nFeatures);
+    distanceFunction = getFixedDistanceFunction(distanceFunction, nFeatures);
+
+    // Each block of training tuples is read once for KNN_BATCH_QUERIES queries, and each query keeps
+    // only its k nearest, so most distances are abandoned after a few features
+#pragma omp parallel for schedule(dynamic)
+    for (unsigned int firstQuery = 0; firstQuery < nQueries; firstQuery += KNN_BATCH_QUERIES) {
+        unsigned int lastQuery = std::min(firstQuery + KNN_BATCH_QUERIES, nQueries);
+        std::vector<std::priority_queue<std::pair<float, unsigned int>>> heaps(lastQuery - firstQuery);
+        std::vector<float>& localTraining = getNumaLocalData(dataTraining);
+        for (unsigned int first = 0; first < nTuples; first += KNN_BATCH_TUPLES) {
+            unsigned int last = std::min(first + KNN_BATCH_TUPLES, nTuples);
+            for (unsigned int q = firstQuery; q < lastQuery; ++q) {
+                addNearestTuples(heaps[q - firstQuery], k, first, last, localTraining, queries, distanceFunction, boundedDistanceFunction, q * nFeatures, nFeatures, config);
+            }
+        }
+
+        for (unsigned int q = firstQuery; q < lastQuery; ++q) {
+            std::vector<std::pair<float, unsigned int>> distances = popNearestDistances(heaps[q - firstQuery], labelsTraining);
+            labelsPredicted[q] = getMostFrequentClass(distances.size(), distances);
+        }
+    }
+
+    return labelsPredicted;
+}
+
+std::vector<unsigned int> getAccuracies(unsigned int nFeatures,
+                                        unsigned short minValueK,
+                                        unsigned short maxValueK,
+                                        std::vector<float>& dataTraining,
+                                        std::vector<float>& dataTest,
+                                        std::vector<unsigned int>& labelsTraining,
+                                        std::vector<unsigned int>& labelsTest,
+                                        float (*distanceFunction)(std::vector<float>&,
+                                                                  std::vector<float>&,
+                                                                  unsigned int,
+                                                                  unsigned int,
+                                                                  unsigned int),
+                                        const Config& config) {
+    std::vector<unsigned int> vectorAccuracies(maxValueK - minValueK + 1, 0);
+
+#pragma omp parallel
+    {
+        // Each thread counts its hits apart and they are added at the end, and reads the training data of its node
+        std::vector<unsigned int> localAccuracies(vectorAccuracies.size(), 0);
+        std::vector<float>& localTraining = getNumaLocalData(dataTraining);
+        unsigned int nTraining = localTraining.size() / config.nFeatures;
+        unsigned int tileTuples = getScanTileTuples(nFeatures);
+        unsigned int lastK = std::min((unsigned int)maxValueK, nTraining);
+        float (*fixedDistanceFunction)(std::vector<float>&,
+                                       std::vector<float>&,
+                                       unsigned int,
+                                       unsigned int,
+                                       unsigned int) = getFixedDistanceFunction(distanceFunction, nFeatures);
+        std::vector<std::vector<uint64_t>> keys(SCAN_TILE_QUERIES);
+        std::vector<uint64_t> scratch;
+        std::vector<std::pair<float, unsigned int>> distances(lastK);
+#pragma omp for schedule(dynamic)
+        for (unsigned int firstTest = 0; firstTest < config.nTuples; firstTest += SCAN_TILE_QUERIES) {
+            // The test tuples of the group are compared with a tile of the training data before the next one, the
+            // first of them brings it to the cache
+            unsigned int lastTest = std::min(firstTest + SCAN_TILE_QUERIES, (unsigned int)config.nTuples);
+            for (unsigned int i = firstTest; i < lastTest; ++i) {
+                keys[i - firstTest].resize(nTraining);
+            }
+            for (unsigned int first = 0; first < nTraining; first += tileTuples) {
+                unsigned int last = std::min(first + tileTuples, nTraining);
+                for (unsigned int i = firstTest; i < lastTest; ++i) {
+                    addDistanceKeys(keys[i - firstTest].data(), first, last, localTraining, dataTest, fixedDistanceFunction, i * config.nFeatures, nFeatures, i == firstTest, config);
+                }
+            }
+
+            for (unsigned int i = firstTest; i < lastTest; ++i) {
+                selectSmallestKeys(keys[i - firstTest], lastK, scratch);
+                for (unsigned int j = 0; j < lastK; ++j) {
+                    distances[j] = std::make_pair(getKeyDistance(keys[i - firstTest][j]), labelsTraining[getKeyPosition(keys[i - firstTest][j])]);
+                }
+                for (unsigned int k = minValueK; k <= lastK; ++k) {
+                    unsigned int labelPredicted = getMostFrequentClass(k, distances);
+                    if (labelPredicted == labelsTest[i]) {
+                        localAccuracies[k - minValueK]++;
+                    }
+                }
+            }
+        }
+#pragma omp critical
+        for (unsigned int i = 0; i < vectorAccuracies.size(); ++i) {
+            vectorAccuracies[i] += localAccuracies[i];
+        }
+    }
+
+    return vectorAccuracies;
 }
 
 std::pair<unsigned int, unsigned int> getBestHyperParamsHomogeneous(unsigned short minValueK,
@@ -94,64 +577,72 @@ std::pair<unsigned int, unsigned int> getBestHyperParamsHomogeneous(unsigned sho
                                                                                               unsigned int),
                                                                     const Config& config,
                                                                     Energy& saving) {
-    unsigned int bestK = 0, bestNFeatures = 0, bestAccuracy = 0;
-
     // Get rank MPI
     int rank = MPI::COMM_WORLD.Get_rank();
     int size = MPI::COMM_WORLD.Get_size();
 
-    // Strided version
-    if (config.stridedHomo) {
-        for (unsigned int f = 1 + rank; f <= config.maxFeatures; f += size) {
-            std::vector<unsigned int> vectorAccuracies(maxValueK - minValueK + 1, 0);
-#pragma omp parallel for schedule(dynamic)
-            for (unsigned int i = 0; i < config.nTuples; ++i) {
-                std::vector<std::pair<float, unsigned int>> distances = getDistances(dataTraining, dataTest, labelsTraining, distanceFunction, i * config.nFeatures, f, config);
-                for (unsigned int k = minValueK; k <= maxValueK; ++k) {
-                    unsigned int labelPredicted = getMostFrequentClass(k, distances);
-                    if (labelPredicted == labelsTest[i]) {
-                        vectorAccuracies[k - minValueK]++;
-                    }
-                }
-            }
-// Iterate for vectorAccuracies
-#pragma omp parallel for schedule(dynamic)
-            for (unsigned int i = 0; i < vectorAccuracies.size(); ++i) {
-                if (vectorAccuracies[i] > bestAccuracy) {
-                    bestAccuracy = vectorAccuracies[i];
-                    bestK = i + minValueK;
-                    bestNFeatures = f;
-                }
-            }
+    // Each process resumes from its own checkpoint, the features of each process never change
+    Checkpoint checkpoint(config.checkpointFile.empty() ? "" : config.checkpointFile + "." + std::to_string(rank),
+                          maxValueK - minValueK + 1, config);
+
+    // Strided version takes one feature of each size, the other one a block of consecutive features
+    unsigned int sizePerProcess = config.maxFeatures / size;
+    unsigned int firstFeature = config.stridedHomo ? 1 + rank : 1 + sizePerProcess * rank;
+    unsigned int stepFeature = config.stridedHomo ? size : 1;
+
+    // The column layout adds the features of the process and the ones between them one by one. The
+    // validation of the precision runs the same sweep in FP32 to compare the accuracies of each k and features
+    std::unique_ptr<FeatureSweep> sweep, sweepFP32;
+    unsigned int lastFeature = firstFeature + (sizePerProcess - 1) * stepFeature;
+    if (config.dataLayout == "column" && FeatureSweep::supports(distanceFunction)) {
+        sweep.reset(new FeatureSweep(dataTraining, dataTest, labelsTraining, distanceFunction, lastFeature, config, getDataPrecision(config.dataPrecision)));
+        if (config.validatePrecision && config.dataPrecision != "fp32") {
+            sweepFP32.reset(new FeatureSweep(dataTraining, dataTest, labelsTraining, distanceFunction, lastFeature, config, PRECISION_FP32));
         }
-    } else {
-        unsigned int sizePerProcess = config.maxFeatures / size;
-        for (unsigned int f = 1 + (sizePerProcess * rank); f <= sizePerProcess * (rank + 1); ++f) {
-            if (config.savingEnergy)
-                saving.checkSleep();
-            std::vector<unsigned int> vectorAccuracies(maxValueK - minValueK + 1, 0);
-#pragma omp parallel for schedule(dynamic)
-            for (unsigned int i = 0; i < config.nTuples; ++i) {
-                std::vector<std::pair<float, unsigned int>> distances = getDistances(dataTraining, dataTest, labelsTraining, distanceFunction, i * config.nFeatures, f, config);
-                for (unsigned int k = minValueK; k <= maxValueK; ++k) {
-                    unsigned int labelPredicted = getMostFrequentClass(k, distances);
-                    if (labelPredicted == labelsTest[i]) {
-                        vectorAccuracies[k - minValueK]++;
+    }
+    unsigned int nCompared = 0, nDifferent = 0, maxDifference = 0;
+    unsigned int best[2][3] = {{0, 0, 0}, {0, 0, 0}};
+
+    for (unsigned int n = 0, f = firstFeature; n < sizePerProcess; ++n, f += stepFeature) {
+        // Every process reaches the same boundaries, even when its features are already done
+        if (config.savingEnergy)
+            saving.syncDecision();
+        if (checkpoint.isDone(f))
+            continue;
+
+        std::vector<unsigned int> accuracies = sweep ? sweep->getAccuracies(f, minValueK, maxValueK, labelsTest)
+                                                     : getAccuracies(f, minValueK, maxValueK, dataTraining, dataTest, labelsTraining, labelsTest, distanceFunction, config);
+        if (sweepFP32) {
+            std::vector<unsigned int> accuraciesFP32 = sweepFP32->getAccuracies(f, minValueK, maxValueK, labelsTest);
+            for (unsigned int i = 0; i < accuracies.size(); ++i) {
+                unsigned int difference = accuracies[i] > accuraciesFP32[i] ? accuracies[i] - accuraciesFP32[i] : accuraciesFP32[i] - accuracies[i];
+                nCompared++;
+                nDifferent += difference != 0;
+                maxDifference = std::max(maxDifference, difference);
+                unsigned int hits[2] = {accuracies[i], accuraciesFP32[i]};
+                for (unsigned int p = 0; p < 2; ++p) {
+                    if (hits[p] > best[p][2]) {
+                        best[p][0] = minValueK + i;
+                        best[p][1] = f;
+                        best[p][2] = hits[p];
                     }
                 }
             }
-// Iterate for vectorAccuracies
-#pragma omp parallel for schedule(dynamic)
-            for (unsigned int i = 0; i < vectorAccuracies.size(); ++i) {
-                if (vectorAccuracies[i] > bestAccuracy) {
-                    bestAccuracy = vectorAccuracies[i];
-                    bestK = i + minValueK;
-                    bestNFeatures = f;
-                }
-            }
         }
+        checkpoint.add(f, accuracies);
+        checkpoint.chunkDone();
+    }
+
+    if (sweepFP32) {
+        std::cout << "Process " << rank << ": " << config.dataPrecision << " against fp32, " << nDifferent << " of " << nCompared
+                  << " accuracies differ, at most by " << maxDifference << " hits. Best k = " << best[0][0] << " with " << best[0][1]
+                  << " features and " << best[0][2] << " hits in " << config.dataPrecision << ", k = " << best[1][0] << " with " << best[1][1]
+                  << " features and " << best[1][2] << " hits in fp32" << std::endl;
     }
 
+    std::vector<unsigned int> bestHyperParamsLocal = checkpoint.getBest(minValueK);
+    unsigned int bestK = bestHyperParamsLocal[0], bestNFeatures = bestHyperParamsLocal[1], bestAccuracy = bestHyperParamsLocal[2];
+
     // The process has best accuracy send bestK and bestNFeatures to root
     std::vector<unsigned int> bestKs(size, 0);
     std::vector<unsigned int> bestNFeaturess(size, 0);
@@ -164,6 +655,9 @@ std::pair<unsigned int, unsigned int> getBestHyperParamsHomogeneous(unsigned sho
     MPI_Gather(&bestNFeatures, 1, MPI_UNSIGNED, bestNFeaturess.data(), 1, MPI_UNSIGNED, 0, MPI_COMM_WORLD);
     MPI_Gather(&bestAccuracy, 1, MPI_UNSIGNED, bestAccuracies.data(), 1, MPI_UNSIGNED, 0, MPI_COMM_WORLD);
 
+    // The search has finished, the next one starts from scratch
+    checkpoint.remove();
+
     // Get index of bestAccuracy
     unsigned int indexBestAccuracy = 0;
     if (!rank) {
@@ -177,45 +671,39 @@ std::pair<unsigned int, unsigned int> getBestHyperParamsHomogeneous(unsigned sho
     return std::make_pair(bestKs[indexBestAccuracy], bestNFeaturess[indexBestAccuracy]);
 }
 
-std::vector<unsigned int> getBestHyperParamsHeterogeneous(unsigned long ptrFeatures,
-                                                          unsigned short minValueK,
-                                                          unsigned short maxValueK,
-                                                          std::vector<float>& dataTraining,
-                                                          std::vector<float>& dataTest,
-                                                          std::vector<unsigned int>& labelsTraining,
-                                                          std::vector<unsigned int>& labelsTest,
-                                                          float (*distanceFunction)(std::vector<float>&,
-                                                                                    std::vector<float>&,
-                                                                                    unsigned int,
-                                                                                    unsigned int,
-                                                                                    unsigned int),
-                                                          const Config& config) {
-    unsigned int bestK = 0, bestNFeatures = 0, bestAccuracy = 0;
+std::vector<unsigned int> getAccuraciesHeterogeneous(unsigned long ptrFeatures,
+                                                     unsigned short minValueK,
+                                                     unsigned short maxValueK,
+                                                     std::vector<float>& dataTraining,
+                                                     std::vector<float>& dataTest,
+                                                     std::vector<unsigned int>& labelsTraining,
+                                                     std::vector<unsigned int>& labelsTest,
+                                                     float (*distanceFunction)(std::vector<float>&,
+                                                                               std::vector<float>&,
+                                                                               unsigned int,
+                                                                               unsigned int,
+                                                                               unsigned int),
+                                                     const Config& config,
+                                                     bool (*interrupted)()) {
+    std::vector<unsigned int> chunkAccuracies;
+    chunkAccuracies.reserve(config.chunkSize * (maxValueK - minValueK + 1));
+
+    // The column layout adds the features before the chunk at once and then the ones of the chunk one by one
+    std::unique_ptr<FeatureSweep> sweep;
+    if (config.dataLayout == "column" && FeatureSweep::supports(distanceFunction)) {
+        sweep.reset(new FeatureSweep(dataTraining, dataTest, labelsTraining, distanceFunction, ptrFeatures + config.chunkSize, config, getDataPrecision(config.dataPrecision)));
+    }
 
     for (unsigned int f = 1 + ptrFeatures; f <= ptrFeatures + config.chunkSize; ++f) {
-        std::vector<unsigned int> vectorAccuracies(maxValueK - minValueK + 1, 0);
-#pragma omp parallel for schedule(dynamic)
-        for (unsigned int i = 0; i < config.nTuples; ++i) {
-            std::vector<std::pair<float, unsigned int>> distances = getDistances(dataTraining, dataTest, labelsTraining, distanceFunction, i * config.nFeatures, f, config);
-            for (unsigned int k = minValueK; k <= maxValueK; ++k) {
-                unsigned int labelPredicted = getMostFrequentClass(k, distances);
-                if (labelPredicted == labelsTest[i]) {
-                    vectorAccuracies[k - minValueK]++;
-                }
-            }
-        }
-// Iterate for vectorAccuracies
-#pragma omp parallel for schedule(dynamic)
-        for (unsigned int i = 0; i < vectorAccuracies.size(); ++i) {
-            if (vectorAccuracies[i] > bestAccuracy) {
-                bestAccuracy = vectorAccuracies[i];
-                bestK = i + minValueK;
-                bestNFeatures = f;
-            }
+        if (interrupted && interrupted()) {
+            return std::vector<unsigned int>();
         }
+        std::vector<unsigned int> vectorAccuracies = sweep ? sweep->getAccuracies(f, minValueK, maxValueK, labelsTest)
+                                                           : getAccuracies(f, minValueK, maxValueK, dataTraining, dataTest, labelsTraining, labelsTest, distanceFunction, config);
+        chunkAccuracies.insert(chunkAccuracies.end(), vectorAccuracies.begin(), vectorAccuracies.end());
     }
 
-    return std::vector<unsigned int>{bestK, bestNFeatures, bestAccuracy};
+    return chunkAccuracies;
 }
 
 std::vector<std::vector<unsigned int>> getConfusionMatrix(std::vector<unsigned int>& labels,
@@ -244,12 +732,14 @@ std::pair<std::vector<unsigned int>, unsigned int> getScoreKNN(int k,
                                                                const Config& config) {
     unsigned int counterSuccess = 0;
     std::vector<unsigned int> labelsPredicted;
-    labelsPredicted.resize(dataTraining.size());
+    labelsPredicted.resize(dataTest.size() / config.nFeatures);
+
+    std::unique_ptr<NeighborIndex> index(createNeighborIndex(dataTraining, labelsTraining, distanceFunction, nFeatures, config));
 
     unsigned int nTuples = dataTest.size() / config.nFeatures;
 #pragma omp parallel for
     for (unsigned int i = 0; i < nTuples; ++i) {
-        unsigned int labelPredicted = KNN(k, dataTraining, dataTest, labelsTraining, distanceFunction, i * config.nFeatures, nFeatures, config);
+        unsigned int labelPredicted = KNN(k, dataTraining, dataTest, labelsTraining, distanceFunction, i * config.nFeatures, nFeatures, config, index.get());
         labelsPredicted[i] = labelPredicted;
         if (labelPredicted == labelsTest[i]) {
 #pragma omp atomic
@@ -260,6 +750,53 @@ std::pair<std::vector<unsigned int>, unsigned int> getScoreKNN(int k,
     return make_pair(labelsPredicted, counterSuccess);
 }
 
+void reportIndexRecall(std::ostream& os,
+                       int k,
+                       std::vector<float>& dataTraining,
+                       std::vector<float>& dataTest,
+                       std::vector<unsigned int>& labelsTraining,
+                       float (*distanceFunction)(std::vector<float>&,
+                                                 std::vector<float>&,
+                                                 unsigned int,
+                                                 unsigned int,
+                                                 unsigned int),
+                       unsigned int nFeatures,
+                       const Config& config) {
+    double start = omp_get_wtime();
+    std::unique_ptr<NeighborIndex> index(createNeighborIndex(dataTraining, labelsTraining, distanceFunction, nFeatures, config));
+    double timeBuild = omp_get_wtime() - start;
+    if (!index) {
+        os << "Index " << config.knnIndex << " uses the full scan with " << nFeatures << " features, its recall is 1" << std::endl;
+        return;
+    }
+
+    unsigned int nTuples = dataTest.size() / config.nFeatures;
+    unsigned long found = 0, total = 0;
+    double timeIndex = 0, timeScan = 0;
+    for (unsigned int i = 0; i < nTuples; ++i) {
+        start = omp_get_wtime();
+        std::vector<std::pair<float, unsigned int>> neighbors = index->getNearestTuples(dataTest, i * config.nFeatures, k);
+        double middle = omp_get_wtime();
+        std::vector<std::pair<float, unsigned int>> distances = getDistances(dataTraining, dataTest, labelsTraining, distanceFunction, i * config.nFeatures, nFeatures, config);
+        timeScan += omp_get_wtime() - middle;
+        timeIndex += middle - start;
+
+        // A neighbor as near as the k-th true one is a hit, whatever tuple it is on a tie. The
+        // distance is computed again because some indexes only approximate it
+        unsigned int nNeighbors = std::min((size_t)k, distances.size());
+        float kthDistance = distances[nNeighbors - 1].first;
+        total += nNeighbors;
+        for (const auto& neighbor : neighbors) {
+            found += distanceFunction(dataTraining, dataTest, neighbor.second * config.nFeatures, i * config.nFeatures, nFeatures) <= kthDistance;
+        }
+    }
+
+    os << "Index " << config.knnIndex << " with " << nFeatures << " features and k = " << k << ":" << std::endl;
+    os << "  Build time: " << timeBuild << " s" << std::endl;
+    os << "  Recall: " << (total ? (double)found / total : 1) << std::endl;
+    os << "  Time per query: " << timeIndex / nTuples * 1e6 << " us with the index, " << timeScan / nTuples * 1e6 << " us with the full scan" << std::endl;
+}
+
 float euclideanDistance(std::vector<float>& dataTraining,
                         std::vector<float>& dataTest,
                         unsigned int ptrDataTraining,
@@ -277,14 +814,60 @@ float euclideanDistance(std::vector<float>& dataTraining,
 
 float manhattanDistance(std::vector<float>& dataTraining,
                         std::vector<float>& dataTest,
-                        unsigned int nFeatures,
                         unsigned int ptrDataTraining,
-                        unsigned int ptrDataTest) {
+                        unsigned int ptrDataTest,
+                        unsigned int nFeatures) {
     float distance = 0;
 
     // #pragma omp parallel for simd reduction(+: distance)
     for (long unsigned int i = 0; i < nFeatures; ++i) {
-        distance += abs((dataTraining[ptrDataTraining + i]) - (dataTest[ptrDataTest + i]));
+        distance += std::fabs((dataTraining[ptrDataTraining + i]) - (dataTest[ptrDataTest + i]));
+    }
+
+    return distance;
+}
+
+float euclideanDistanceBounded(std::vector<float>& dataTraining,
+                               std::vector<float>& dataTest,
+                               unsigned int ptrDataTraining,
+                               unsigned int ptrDataTest,
+                               unsigned int nFeatures,
+                               float bound) {
+    float distance = 0;
+
+    // Exact in double, the sum is compared before the square root
+    double boundSquared = (double)bound * bound;
+    unsigned int i = 0;
+    while (i < nFeatures) {
+        unsigned int end = std::min(i + DISTANCE_ABANDON_BLOCK, nFeatures);
+        for (; i < end; ++i) {
+            distance += pow((dataTraining[ptrDataTraining + i]) - (dataTest[ptrDataTest + i]), 2);
+        }
+        if (distance > boundSquared) {
+            return INFINITY;
+        }
+    }
+
+    return sqrt(distance);
+}
+
+float manhattanDistanceBounded(std::vector<float>& dataTraining,
+                               std::vector<float>& dataTest,
+                               unsigned int ptrDataTraining,
+                               unsigned int ptrDataTest,
+                               unsigned int nFeatures,
+                               float bound) {
+    float distance = 0;
+
+    unsigned int i = 0;
+    while (i < nFeatures) {
+        unsigned int end = std::min(i + DISTANCE_ABANDON_BLOCK, nFeatures);
+        for (; i < end; ++i) {
+            distance += std::fabs((dataTraining[ptrDataTraining + i]) - (dataTest[ptrDataTest + i]));
+        }
+        if (distance > bound) {
+            return INFINITY;
+        }
     }
 
     return distance;
@@ -0,0 +1,122 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file laesa.cpp
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Implementation of the pivot table (LAESA)
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+/********************************* Includes *******************************/
+#include "laesa.h"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+
+/******************************** Constants *******************************/
+
+/********************************* Methods ********************************/
+LAESA::LAESA(std::vector<float>& dataTraining,
+             std::vector<unsigned int>& labelsTraining,
+             float (*distanceFunction)(std::vector<float>&,
+                                       std::vector<float>&,
+                                       unsigned int,
+                                       unsigned int,
+                                       unsigned int),
+             unsigned int nFeatures,
+             const Config& config)
+    : NeighborIndex(labelsTraining),
+      dataTraining(dataTraining),
+      distanceFunction(distanceFunction),
+      nFeatures(nFeatures),
+      stride(config.nFeatures),
+      maxDistance(0) {
+    unsigned int nTuples = dataTraining.size() / config.nFeatures;
+    unsigned int nPivots = std::min(config.laesaPivots, nTuples);
+    this->isPivot.assign(nTuples, false);
+    this->table.resize((size_t)nTuples * nPivots);
+
+    // Each pivot is the tuple farthest from the pivots already chosen, starting from the first tuple
+    std::vector<float> minDistances(nTuples, INFINITY);
+    unsigned int pivot = 0;
+    for (unsigned int p = 0; p < nPivots; ++p) {
+        this->pivots.push_back(pivot);
+        this->isPivot[pivot] = true;
+#pragma omp parallel for
+        for (unsigned int i = 0; i < nTuples; ++i) {
+            float distance = this->distanceFunction(dataTraining, dataTraining, i * this->stride, pivot * this->stride, nFeatures);
+            this->table[(size_t)i * nPivots + p] = distance;
+            minDistances[i] = std::min(minDistances[i], distance);
+        }
+        pivot = std::max_element(minDistances.begin(), minDistances.end()) - minDistances.begin();
+    }
+
+    if (!this->table.empty()) {
+        this->maxDistance = *std::max_element(this->table.begin(), this->table.end());
+    }
+}
+
+std::vector<std::pair<float, unsigned int>> LAESA::getNearestTuples(std::vector<float>& dataTest, unsigned int ptrDataTest, unsigned int k) const {
+    unsigned int nPivots = this->pivots.size();
+    unsigned int nTuples = this->isPivot.size();
+    std::priority_queue<std::pair<float, unsigned int>> heap;
+
+    // The distances to the pivots are also the distances to some tuples
+    std::vector<float> pivotDistances(nPivots);
+    float maxPivotDistance = 0;
+    for (unsigned int p = 0; p < nPivots; ++p) {
+        pivotDistances[p] = this->distanceFunction(this->dataTraining, dataTest, this->pivots[p] * this->stride, ptrDataTest, this->nFeatures);
+        maxPivotDistance = std::max(maxPivotDistance, pivotDistances[p]);
+        std::pair<float, unsigned int> candidate(pivotDistances[p], this->pivots[p]);
+        if (heap.size() < k) {
+            heap.push(candidate);
+        } else if (candidate < heap.top()) {
+            heap.pop();
+            heap.push(candidate);
+        }
+    }
+    float tolerance = LAESA_PRUNE_SLACK * (maxPivotDistance + this->maxDistance);
+
+    for (unsigned int i = 0; i < nTuples; ++i) {
+        if (this->isPivot[i]) {
+            continue;
+        }
+
+        if (heap.size() >= k) {
+            const float* distances = &this->table[(size_t)i * nPivots];
+            float bound = 0;
+            for (unsigned int p = 0; p < nPivots; ++p) {
+                bound = std::max(bound, std::fabs(pivotDistances[p] - distances[p]));
+            }
+            if (bound > heap.top().first + tolerance) {
+                continue;
+            }
+        }
+
+        std::pair<float, unsigned int> candidate(this->distanceFunction(this->dataTraining, dataTest, i * this->stride, ptrDataTest, this->nFeatures), i);
+        if (heap.size() < k) {
+            heap.push(candidate);
+        } else if (candidate < heap.top()) {
+            heap.pop();
+            heap.push(candidate);
+        }
+    }
+
+    std::vector<std::pair<float, unsigned int>> neighbors(heap.size());
+    for (auto it = neighbors.rbegin(); it != neighbors.rend(); ++it) {
+        *it = heap.top();
+        heap.pop();
+    }
+
+    return neighbors;
+}
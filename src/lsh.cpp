@@ -0,0 +1,148 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file lsh.cpp
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Implementation of the locality-sensitive hashing index
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+/********************************* Includes *******************************/
+#include "lsh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <random>
+
+/******************************** Constants *******************************/
+
+/********************************* Methods ********************************/
+LSH::LSH(std::vector<float>& dataTraining,
+         std::vector<unsigned int>& labelsTraining,
+         float (*distanceFunction)(std::vector<float>&,
+                                   std::vector<float>&,
+                                   unsigned int,
+                                   unsigned int,
+                                   unsigned int),
+         unsigned int nFeatures,
+         const Config& config)
+    : NeighborIndex(labelsTraining),
+      dataTraining(dataTraining),
+      distanceFunction(distanceFunction),
+      nFeatures(nFeatures),
+      stride(config.nFeatures),
+      nHashes(std::max(1U, config.lshHashes)),
+      maxCandidates(config.lshCandidates),
+      cosine(config.lshFamily == "cosine"),
+      width(config.lshWidth) {
+    unsigned int nTables = std::max(1U, config.lshTables);
+    unsigned int nProjections = nTables * this->nHashes;
+
+    // The gaussian is 2-stable and the cauchy 1-stable, so the projections keep the l2 and l1 distances
+    std::mt19937 generator(LSH_SEED);
+    std::normal_distribution<float> normal(0, 1);
+    std::cauchy_distribution<float> cauchy(0, 1);
+    std::uniform_real_distribution<float> uniform(0, this->width);
+    this->projections.resize((size_t)nProjections * nFeatures);
+    for (float& value : this->projections) {
+        value = config.lshFamily == "l1" ? cauchy(generator) : normal(generator);
+    }
+    this->offsets.resize(nProjections);
+    for (float& offset : this->offsets) {
+        offset = uniform(generator);
+    }
+
+    unsigned int nTuples = dataTraining.size() / config.nFeatures;
+    this->tables.resize(nTables);
+#pragma omp parallel for
+    for (unsigned int t = 0; t < nTables; ++t) {
+        for (unsigned int i = 0; i < nTuples; ++i) {
+            this->tables[t][this->getKey(dataTraining, i * this->stride, t)].push_back(i);
+        }
+    }
+}
+
+uint64_t LSH::getKey(const std::vector<float>& data, unsigned int ptrData, unsigned int table) const {
+    uint64_t key = 14695981039346656037ULL;
+
+    for (unsigned int h = 0; h < this->nHashes; ++h) {
+        unsigned int projection = table * this->nHashes + h;
+        const float* values = &this->projections[(size_t)projection * this->nFeatures];
+        float dot = 0;
+        for (unsigned int f = 0; f < this->nFeatures; ++f) {
+            dot += values[f] * data[ptrData + f];
+        }
+
+        // FNV-1a of the bucket of each projection
+        int64_t bucket = this->cosine ? dot >= 0 : (int64_t)std::floor((dot + this->offsets[projection]) / this->width);
+        key = (key ^ (uint64_t)bucket) * 1099511628211ULL;
+    }
+
+    return key;
+}
+
+std::vector<std::pair<float, unsigned int>> LSH::getNearestTuples(std::vector<float>& dataTest, unsigned int ptrDataTest, unsigned int k) const {
+    unsigned int nTuples = this->dataTraining.size() / this->stride;
+
+    // The candidates are marked with the number of the query, so the marks are never cleared
+    static thread_local std::vector<unsigned int> marks;
+    static thread_local unsigned int query = 0;
+    if (marks.size() < nTuples || ++query == 0) {
+        marks.assign(std::max((unsigned int)marks.size(), nTuples), 0);
+        query = 1;
+    }
+
+    std::vector<unsigned int> candidates;
+    for (unsigned int t = 0; t < this->tables.size() && (!this->maxCandidates || candidates.size() < this->maxCandidates); ++t) {
+        auto bucket = this->tables[t].find(this->getKey(dataTest, ptrDataTest, t));
+        if (bucket == this->tables[t].end()) {
+            continue;
+        }
+        for (unsigned int tuple : bucket->second) {
+            if (marks[tuple] != query) {
+                marks[tuple] = query;
+                candidates.push_back(tuple);
+            }
+        }
+    }
+    if (this->maxCandidates && candidates.size() > this->maxCandidates) {
+        candidates.resize(this->maxCandidates);
+    }
+
+    // Too few candidates, the k neighbors are looked for in the whole training data
+    if (candidates.size() < std::min(k, nTuples)) {
+        candidates.resize(nTuples);
+        for (unsigned int i = 0; i < nTuples; ++i) {
+            candidates[i] = i;
+        }
+    }
+
+    std::priority_queue<std::pair<float, unsigned int>> heap;
+    for (unsigned int tuple : candidates) {
+        std::pair<float, unsigned int> candidate(this->distanceFunction(this->dataTraining, dataTest, tuple * this->stride, ptrDataTest, this->nFeatures), tuple);
+        if (heap.size() < k) {
+            heap.push(candidate);
+        } else if (candidate < heap.top()) {
+            heap.pop();
+            heap.push(candidate);
+        }
+    }
+
+    std::vector<std::pair<float, unsigned int>> neighbors(heap.size());
+    for (auto it = neighbors.rbegin(); it != neighbors.rend(); ++it) {
+        *it = heap.top();
+        heap.pop();
+    }
+
+    return neighbors;
+}
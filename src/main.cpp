@@ -26,15 +26,22 @@
 
 #include <algorithm>
 #include <cstring>
+#include <deque>
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <set>
 #include <vector>
 
+#include "checkpoint.h"
+#include "condensation.h"
 #include "config.h"
 #include "db.h"
+#include "energyCounter.h"
 #include "energySaving.h"
 #include "knn.h"
+#include "numaPlacement.h"
+#include "server.h"
 #include "util.h"
 
 #define TAG_RESULT 0
@@ -42,55 +49,211 @@
 #define TAG_JOB_DATA 2
 #define TAG_STOP 3
 
+#define MASTER_POLL_US 1000
+
 using namespace std;
 
 /**
  * @brief master function executed by the master process
- * managing the slaves with send jobs and receiving results using dinamyc balancing
+ * managing the slaves with send jobs and receiving results using dinamyc balancing.
+ * When there are no more chunks, the chunks that run longer than stragglerFactor times the
+ * mean time of a chunk are sent again to the idle slaves and the first result is used.
+ * Slaves with a chunk running more than slaveTimeout seconds are excluded, their chunk goes back to
+ * the pending ones, and a late result of it is still used while it is pending. The search ends
+ * when no chunk is pending or running, then the busy slaves are stopped, they leave their chunk at
+ * the next feature. The excluded slaves are sent the stop but the master does not wait for them
  * @param config configuration parameters
+ * @param saving energy saving parameters, the master owns the price feed
+ * @param lostSlaves set to true if an excluded slave never acknowledged the stop, it cannot join a collective
  * @return pair of the best k and the best accuracy
  */
-pair<unsigned int, unsigned int> master(const Config& config) {
-    const unsigned int TAM = 3;
-    unsigned int chunkProcessed = 0, slavesDone = 0, bestAccuracy = 0;
-    pair<unsigned int, unsigned int> bestHyperParamsGlobal = make_pair(0, 0);
-    vector<unsigned int> bestHyperParamsLocal;
-    bestHyperParamsLocal.resize(TAM);
+pair<unsigned int, unsigned int> master(const Config& config, Energy& saving, bool& lostSlaves) {
+    // Each result has the pointer of the chunk and the accuracies of each k for each feature of the chunk
+    const unsigned int nK = config.nTuples;
+    unsigned int chunksDone = 0;
+    double timeChunksDone = 0;
+    vector<unsigned int> chunkResult(1 + config.chunkSize * nK);
+
+    // Resume from the chunks done in a previous execution
+    Checkpoint checkpoint(config.checkpointFile, nK, config);
+
+    // Chunks not sent yet, chunks sent and not finished with the ranks working on them, and the
+    // chunk and dispatch time of each busy slave
+    deque<unsigned int> pendingChunks;
+    map<unsigned int, set<int>> runningChunks;
+    map<int, pair<unsigned int, double>> busySlaves;
+    set<int> idleSlaves, excludedSlaves, stoppedSlaves, doneSlaves;
+
+    for (unsigned int chunk = 0; chunk < config.maxFeatures; chunk += config.chunkSize) {
+        if (!checkpoint.isChunkDone(chunk, config.chunkSize)) {
+            pendingChunks.push_back(chunk);
+        }
+    }
 
     MPI_Status status;
+    int hasMessage;
     unsigned int totalSlaves = MPI::COMM_WORLD.Get_size() - 1;
 
-    // while (/* there are jobs unprocessed */ || /* there are slaves still working on jobs */) {
-    while (slavesDone != totalSlaves) {
-        // Wait for incoming slave message
-        MPI_Probe(MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
-        // Store rank of the slave who sent the message
-        int slaveRank = status.MPI_SOURCE;
-
-        if (status.MPI_TAG == TAG_ASK_FOR_JOB) {
-            // If the slave is ready to receive a job, send it one
-            MPI_Recv(NULL, 0, MPI_INT, slaveRank, TAG_ASK_FOR_JOB, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-            if (chunkProcessed < config.maxFeatures) {
-                MPI_Send(&chunkProcessed, 1, MPI_UNSIGNED, slaveRank, TAG_JOB_DATA, MPI_COMM_WORLD);
-                chunkProcessed += config.chunkSize;
+    // While there are chunks not done or slaves that have not acknowledged the stop, the excluded
+    // ones may be dead and are not waited for
+    unsigned int slavesDone = 0;
+    while (!pendingChunks.empty() || !runningChunks.empty() || slavesDone != totalSlaves) {
+        // Send the new run/pause decisions before giving more work
+        if (config.savingEnergy) {
+            saving.publishDecision();
+        }
+
+        // Look for incoming slave message, without blocking to watch the running chunks
+        MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &hasMessage, &status);
+        if (hasMessage) {
+            // Store rank of the slave who sent the message
+            int slaveRank = status.MPI_SOURCE;
+
+            if (status.MPI_TAG == TAG_ASK_FOR_JOB) {
+                // The slave waits until there is a job for it or the search finishes
+                MPI_Recv(NULL, 0, MPI_INT, slaveRank, TAG_ASK_FOR_JOB, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+                if (!stoppedSlaves.count(slaveRank)) {
+                    idleSlaves.insert(slaveRank);
+                }
+            } else if (status.MPI_TAG == TAG_RESULT) {
+                // If the slave sent a result, process it
+                MPI_Recv(chunkResult.data(), chunkResult.size(), MPI_UNSIGNED, slaveRank, TAG_RESULT, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+                unsigned int chunk = chunkResult[0];
+                auto busy = busySlaves.find(slaveRank);
+                if (busy != busySlaves.end()) {
+                    timeChunksDone += MPI_Wtime() - busy->second.second;
+                    chunksDone++;
+                    busySlaves.erase(busy);
+                }
+
+                auto pending = find(pendingChunks.begin(), pendingChunks.end(), chunk);
+                if (runningChunks.count(chunk) || pending != pendingChunks.end()) {
+                    // A chunk of an excluded slave may be pending again when its result arrives
+                    if (pending != pendingChunks.end()) {
+                        pendingChunks.erase(pending);
+                    }
+                    for (unsigned int c = 0; c < config.chunkSize; ++c) {
+                        auto begin = chunkResult.begin() + 1 + c * nK;
+                        checkpoint.add(chunk + 1 + c, vector<unsigned int>(begin, begin + nK));
+                    }
+                    checkpoint.chunkDone();
+                    runningChunks.erase(chunk);
+                } else {
+                    // Another slave finished the same chunk first
+                    printf("Master: discarding duplicate result of chunk %u from slave %d\n", chunk, slaveRank);
+                }
             } else {
-                // Send stop message to the slave
-                MPI_Send(NULL, 0, MPI_INT, slaveRank, TAG_STOP, MPI_COMM_WORLD);
-            }
-        } else if (status.MPI_TAG == TAG_RESULT) {
-            // If the slave sent a result, process it
-            MPI_Recv(&bestHyperParamsLocal[0], TAM, MPI_UNSIGNED, slaveRank, TAG_RESULT, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-            if (bestHyperParamsLocal[2] > bestAccuracy) {
-                bestHyperParamsGlobal = make_pair(bestHyperParamsLocal[0], bestHyperParamsLocal[1]);
-                bestAccuracy = bestHyperParamsLocal[2];
+                MPI_Recv(NULL, 0, MPI_INT, slaveRank, TAG_STOP, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+                doneSlaves.insert(slaveRank);
             }
         } else {
-            MPI_Recv(NULL, 0, MPI_INT, slaveRank, TAG_STOP, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-            slavesDone++;
+            usleep(MASTER_POLL_US);
+        }
+
+        double now = MPI_Wtime();
+
+        // Exclude the slaves that stopped responding, its chunk is given to another slave
+        if (config.slaveTimeout > 0) {
+            for (auto busy = busySlaves.begin(); busy != busySlaves.end();) {
+                if (now - busy->second.second > config.slaveTimeout) {
+                    unsigned int chunk = busy->second.first;
+                    printf("Master: slave %d does not respond after %.1f seconds with chunk %u, it is excluded\n", busy->first, now - busy->second.second, chunk);
+                    excludedSlaves.insert(busy->first);
+                    runningChunks[chunk].erase(busy->first);
+                    if (runningChunks[chunk].empty()) {
+                        runningChunks.erase(chunk);
+                        pendingChunks.push_front(chunk);
+                    }
+                    busy = busySlaves.erase(busy);
+                } else {
+                    ++busy;
+                }
+            }
+        }
+
+        // Without slaves the chunks left would never be done, the chunks done are kept for a new execution
+        if (excludedSlaves.size() == totalSlaves && (!pendingChunks.empty() || !runningChunks.empty())) {
+            checkpoint.save();
+            check(true, "%s\n", ERROR_NO_SLAVES);
+        }
+
+        // When every chunk is done, stop all the slaves, also the ones still working on copies
+        if (pendingChunks.empty() && runningChunks.empty()) {
+            for (int slaveRank = 1; slaveRank <= (int)totalSlaves; ++slaveRank) {
+                if (stoppedSlaves.insert(slaveRank).second) {
+                    MPI_Send(NULL, 0, MPI_INT, slaveRank, TAG_STOP, MPI_COMM_WORLD);
+                }
+            }
+            idleSlaves.clear();
+            busySlaves.clear();
+        }
+
+        // Give work to the idle slaves, new chunks first and then copies of the stragglers
+        for (auto idle = idleSlaves.begin(); idle != idleSlaves.end();) {
+            int slaveRank = *idle;
+            bool dispatched = false;
+
+            if (excludedSlaves.count(slaveRank)) {
+                // An excluded slave that answers again is stopped
+                MPI_Send(NULL, 0, MPI_INT, slaveRank, TAG_STOP, MPI_COMM_WORLD);
+                stoppedSlaves.insert(slaveRank);
+                dispatched = true;
+            } else if (!pendingChunks.empty()) {
+                unsigned int chunk = pendingChunks.front();
+                pendingChunks.pop_front();
+                MPI_Send(&chunk, 1, MPI_UNSIGNED, slaveRank, TAG_JOB_DATA, MPI_COMM_WORLD);
+                runningChunks[chunk].insert(slaveRank);
+                busySlaves[slaveRank] = make_pair(chunk, now);
+                dispatched = true;
+            } else if (config.stragglerFactor > 0 && chunksDone) {
+                // The oldest chunk with only one copy, if it has been running too long
+                double meanChunkTime = timeChunksDone / chunksDone;
+                int straggler = -1;
+                for (const auto& busy : busySlaves) {
+                    if (runningChunks[busy.second.first].size() == 1 && now - busy.second.second > config.stragglerFactor * meanChunkTime &&
+                        (straggler < 0 || busy.second.second < busySlaves[straggler].second)) {
+                        straggler = busy.first;
+                    }
+                }
+                if (straggler >= 0) {
+                    unsigned int chunk = busySlaves[straggler].first;
+                    printf("Master: slave %d is straggling with chunk %u, speculative copy sent to slave %d\n", straggler, chunk, slaveRank);
+                    MPI_Send(&chunk, 1, MPI_UNSIGNED, slaveRank, TAG_JOB_DATA, MPI_COMM_WORLD);
+                    runningChunks[chunk].insert(slaveRank);
+                    busySlaves[slaveRank] = make_pair(chunk, now);
+                    dispatched = true;
+                }
+            }
+
+            idle = dispatched ? idleSlaves.erase(idle) : ++idle;
+        }
+
+        slavesDone = doneSlaves.size();
+        for (int slaveRank : excludedSlaves) {
+            slavesDone += !doneSlaves.count(slaveRank);
         }
     }
 
-    return bestHyperParamsGlobal;
+    if (!excludedSlaves.empty()) {
+        printf("Master: %lu slaves were excluded because they did not respond\n", excludedSlaves.size());
+    }
+    lostSlaves = doneSlaves.size() != totalSlaves;
+
+    // The search has finished, the next one starts from scratch
+    checkpoint.remove();
+
+    vector<unsigned int> bestHyperParams = checkpoint.getBest(1);
+    return make_pair(bestHyperParams[0], bestHyperParams[1]);
+}
+
+/**
+ * @brief Check if the master has sent a stop message to this slave
+ * @return true if the slave must stop
+ */
+bool isStopped() {
+    int stopped;
+    MPI_Iprobe(0, TAG_STOP, MPI_COMM_WORLD, &stopped, MPI_STATUS_IGNORE);
+    return stopped;
 }
 
 /**
@@ -114,6 +277,11 @@ void slave(vector<float>& dataTraining,
     MPI_Status status;
 
     do {
+        // The energy pause is taken before asking, so the master does not time a chunk of a paused slave
+        if (config.savingEnergy) {
+            saving.checkSleep();
+        }
+
         // First send message to master to ask for a job, and wait for job
         MPI_Send(NULL, 0, MPI_INT, 0, TAG_ASK_FOR_JOB, MPI_COMM_WORLD);
         MPI_Probe(0, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
@@ -121,12 +289,17 @@ void slave(vector<float>& dataTraining,
         if (status.MPI_TAG == TAG_JOB_DATA) {
             // Work with data received, process it
             MPI_Recv(&chunkToProcess, 1, MPI_INT, 0, TAG_JOB_DATA, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-            if (config.savingEnergy) {
-                saving.checkSleep();
+            vector<unsigned int> chunkResult{chunkToProcess};
+            vector<unsigned int> chunkAccuracies = getAccuraciesHeterogeneous(chunkToProcess, 1, config.nTuples, dataTraining, dataTest, labelsTraining, labelsTest, euclideanDistance, config, isStopped);
+            if (chunkAccuracies.empty()) {
+                // The search finished while this chunk was running, it was a copy or the slave was excluded
+                MPI_Recv(NULL, 0, MPI_INT, 0, TAG_STOP, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+                MPI_Send(NULL, 0, MPI_INT, 0, TAG_STOP, MPI_COMM_WORLD);
+                break;
             }
-            vector<unsigned int> bestHyperParamsLocal = getBestHyperParamsHeterogeneous(chunkToProcess, 1, config.nTuples, dataTraining, dataTest, labelsTraining, labelsTest, euclideanDistance, config);
+            chunkResult.insert(chunkResult.end(), chunkAccuracies.begin(), chunkAccuracies.end());
             // Send result to master
-            MPI_Send(&bestHyperParamsLocal[0], bestHyperParamsLocal.size(), MPI_UNSIGNED, 0, TAG_RESULT, MPI_COMM_WORLD);
+            MPI_Send(chunkResult.data(), chunkResult.size(), MPI_UNSIGNED, 0, TAG_RESULT, MPI_COMM_WORLD);
 
             printf("Job done");
         } else {
@@ -145,11 +318,11 @@ void slave(vector<float>& dataTraining,
  * @param argv Arguments of the program
  */
 int main(int argc, char* argv[]) {
-    int size, rank, namelen;
+    int size, rank, namelen, provided;
     char processor_name[MPI_MAX_PROCESSOR_NAME];
 
-    // Initialize enviroment MPI
-    MPI_Init(&argc, &argv);
+    // Initialize enviroment MPI, the work is done by an OpenMP thread that may not be the main one
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
     MPI_Comm_rank(MPI_COMM_WORLD, &rank);
     MPI_Comm_size(MPI_COMM_WORLD, &size);
     MPI_Get_processor_name(processor_name, &namelen);
@@ -158,88 +331,164 @@ int main(int argc, char* argv[]) {
     Config config(argc, argv);
 
     // Initialize the energy to save the energy consumption
-    Energy saving;
+    Energy saving(config);
+
+    // Initialize the RAPL counters to measure the energy of each phase
+    EnergyCounter counter;
 
-    bool isMaster = (config.mode == "hetero" && rank == 0);
+    check(provided < MPI_THREAD_SERIALIZED, "%s\n", ERROR_MPI_THREAD);
+
+    // Only one process fetches the energy price and decides for the whole cluster
+    bool isEnergyOwner = (rank == ENERGY_OWNER_RANK);
 
     omp_set_nested(1);
     // omp_set_max_active_levels(2);
-#pragma omp parallel num_threads(2) if (config.savingEnergy && !isMaster)
+    // The serve mode does not run the search, so it does not follow the energy price
+    bool followEnergyPrice = config.savingEnergy && isEnergyOwner && config.mode != "serve";
+
+#pragma omp parallel num_threads(2) if (followEnergyPrice)
     {
         int np = omp_get_num_threads();
         int iam = omp_get_thread_num();
         // printf thread id
         printf("Hybrid: Hello from thread %d/%d from process %d/%d on %s\n", iam, np, rank, size, processor_name);
-        if (omp_get_thread_num() == 0 && config.savingEnergy && !isMaster) {
-            // Initialize the energy saving to save the energy consumption
+        if (omp_get_thread_num() == 0 && followEnergyPrice) {
+            // Initialize the energy saving to save the energy consumption, until the work ends
             saving.checkEnergyPrice();
-        }
+        } else {
+            // Vars for use in both modes
+            vector<float> dataTraining, dataTest;
+            vector<unsigned int> labelsTraining, labelsTest, MRMR;
+            pair<unsigned int, unsigned int> bestHyperParams;
+            bool lostSlaves = false;
+            double start, end;
 
-        // Check if saving energy param is true and if it is, check if has sleep time to sleep
-        if (config.savingEnergy && !isMaster) {
-            saving.checkSleep();
-        }
+            // 1. Read data from files
+            counter.start(PHASE_LOAD);
+            readDataFromFiles(dataTraining, dataTest, labelsTraining, labelsTest, MRMR, config);
+            counter.stop();
 
-        // Vars for use in both modes
-        vector<float> dataTraining, dataTest;
-        vector<unsigned int> labelsTraining, labelsTest, MRMR;
-        pair<unsigned int, unsigned int> bestHyperParams;
-        double start, end;
+            // The serve mode normalizes the queries with the range of the training data
+            pair<float, float> minMaxTraining = min_max_value(dataTraining);
 
-        // 1. Read data from files
-        readDataFromFiles(dataTraining, dataTest, labelsTraining, labelsTest, MRMR, config);
+            // Normalize the data, get best scores
+            if (config.normalize) {
+                counter.start(PHASE_NORMALIZE);
+                normalizeData(dataTraining, dataTest);
+                counter.stop();
+            }
 
-        // 2. Sorting by best features (MRMR), get best scores
-        if (config.sortingByMRMR) {
-            sortFeaturesByMRMR(dataTraining, dataTest, MRMR, config);
-        }
+            // 2. Sorting by best features (MRMR), get best scores
+            if (config.sortingByMRMR) {
+                counter.start(PHASE_MRMR);
+                sortFeaturesByMRMR(dataTraining, dataTest, MRMR, config);
+                counter.stop();
+            }
+
+            // The serve mode classifies with the condensed training data
+            if (config.mode == "serve" && !rank && config.condensation != "none") {
+                condenseTrainingData(dataTraining, labelsTraining, euclideanDistance, config.serveNFeatures, config);
+                cout << "Training tuples after the condensation " << config.condensation << ": " << labelsTraining.size() << endl;
+            }
 
-        // Mode homo for homogeneous platforms, static balancing
-        if (config.mode == "homo") {
-            // Present each process with mpi
-            // printf("\nHello from process %d/%d on %s\n", rank, size, processor_name);
+            // The training data is placed in the NUMA nodes once it has its final values
+            placeNuma(cout, dataTraining, config);
 
-            // 3. Get the best k and number of features to use, floor(sqrt(config.nTuples)) // Recommended
-            while (true) {
-                start = MPI_Wtime();
-                if (config.savingEnergy) {
-                    saving.checkSleep();
+            // Mode serve, the first process classifies the requests of the clients until it is killed
+            if (config.mode == "serve") {
+                if (!rank) {
+                    KNNServer server(config, dataTraining, labelsTraining, minMaxTraining.first, minMaxTraining.second);
+                    server.run();
+                }
+            } else if (config.mode == "homo") {
+                // Mode homo for homogeneous platforms, static balancing
+                // Present each process with mpi
+                // printf("\nHello from process %d/%d on %s\n", rank, size, processor_name);
+
+                // 3. Get the best k and number of features to use, floor(sqrt(config.nTuples)) // Recommended
+                for (unsigned int run = 0; !config.nRuns || run < config.nRuns; ++run) {
+                    start = MPI_Wtime();
+                    if (config.savingEnergy) {
+                        saving.syncDecision();
+                    }
+                    counter.start(PHASE_SEARCH);
+                    bestHyperParams = getBestHyperParamsHomogeneous(1, config.nTuples, dataTraining, dataTest, labelsTraining, labelsTest, euclideanDistance, config, saving);
+                    counter.stop();
+                    end = MPI_Wtime();
+                }
+
+            } else if (config.mode == "hetero") {
+                // Mode hetero for heterogeneous platforms, dynamic balancing
+                for (unsigned int run = 0; !config.nRuns || run < config.nRuns; ++run) {
+                    counter.start(PHASE_SEARCH);
+                    if (!rank) {
+                        start = MPI_Wtime();
+                        bestHyperParams = master(config, saving, lostSlaves);
+                        end = MPI_Wtime();
+                    } else {
+                        slave(dataTraining, dataTest, labelsTraining, labelsTest, config, saving);
+                    }
+                    counter.stop();
+                    // No barrier, the slaves have acknowledged the stop and an excluded one may be dead
+                }
+
+                // No decision is left unreceived and no slave keeps waiting for one
+                if (config.savingEnergy && !lostSlaves) {
+                    saving.endDecisions();
                 }
-                bestHyperParams = getBestHyperParamsHomogeneous(1, config.nTuples, dataTraining, dataTest, labelsTraining, labelsTest, euclideanDistance, config, saving);
-                end = MPI_Wtime();
             }
 
-        } else if (config.mode == "hetero") {
-            // Mode hetero for heterogeneous platforms, dynamic balancing
-            while (true) {
-                if (!rank) {
+            if (!rank && config.mode != "serve") {
+                cout << "Best value of k: " << bestHyperParams.first << "\nBest numbers of features: " << bestHyperParams.second << endl;
+                // cout << "Time getBestHyperParams: " << end - start << endl;
+                // 4. To finalize get the score of the best k and number of features
+                start = MPI_Wtime();
+                counter.start(PHASE_SCORE);
+                pair<vector<unsigned int>, unsigned int> scoreTest = getScoreKNN(bestHyperParams.first, dataTraining, dataTest, labelsTraining, labelsTest, euclideanDistance, bestHyperParams.second, config);
+                pair<vector<unsigned int>, unsigned int> scoreTraining = getScoreKNN(bestHyperParams.first, dataTraining, dataTraining, labelsTraining, labelsTraining, euclideanDistance, bestHyperParams.second, config);
+                counter.stop();
+                end = MPI_Wtime();
+                cout << "Time KNN: " << end - start << endl;
+
+                // 5. Get Confusion Matrix for test
+                vector<vector<unsigned int>> confusionMatrixTest = getConfusionMatrix(labelsTest, scoreTest.first, config.nClasses);
+                cout << "Confusion Matrix Test: " << endl;
+                printMatrix(confusionMatrixTest);
+
+                cout << "Accuracy of K-NN classifier on training set: " << ((float)scoreTraining.second / (float)config.nTuples) << endl;
+                cout << "Accuracy of K-NN classifier on test set: " << ((float)scoreTest.second / (float)config.nTuples) << endl;
+
+                if (config.reportRecall) {
+                    reportIndexRecall(cout, bestHyperParams.first, dataTraining, dataTest, labelsTraining, euclideanDistance, bestHyperParams.second, config);
+                }
+
+                // The training data is reduced with the best number of features, the search uses all of it
+                if (config.condensation != "none") {
+                    vector<float> dataCondensed(dataTraining);
+                    vector<unsigned int> labelsCondensed(labelsTraining);
                     start = MPI_Wtime();
-                    bestHyperParams = master(config);
+                    condenseTrainingData(dataCondensed, labelsCondensed, euclideanDistance, bestHyperParams.second, config);
                     end = MPI_Wtime();
-                } else {
-                    slave(dataTraining, dataTest, labelsTraining, labelsTest, config, saving);
+                    pair<vector<unsigned int>, unsigned int> scoreCondensed = getScoreKNN(bestHyperParams.first, dataCondensed, dataTest, labelsCondensed, labelsTest, euclideanDistance, bestHyperParams.second, config);
+                    cout << "Condensation " << config.condensation << ": " << labelsTraining.size() << " -> " << labelsCondensed.size() << " training tuples in " << end - start << " s" << endl;
+                    cout << "Accuracy of K-NN classifier on test set with the condensed training set: " << ((float)scoreCondensed.second / (float)config.nTuples)
+                         << " (" << ((float)scoreCondensed.second - (float)scoreTest.second) / (float)config.nTuples << ")" << endl;
                 }
-                MPI_Barrier(MPI_COMM_WORLD);
             }
-        }
 
-        if (!rank) {
-            cout << "Best value of k: " << bestHyperParams.first << "\nBest numbers of features: " << bestHyperParams.second << endl;
-            // cout << "Time getBestHyperParams: " << end - start << endl;
-            // 4. To finalize get the score of the best k and number of features
-            start = MPI_Wtime();
-            pair<vector<unsigned int>, unsigned int> scoreTest = getScoreKNN(bestHyperParams.first, dataTraining, dataTest, labelsTraining, labelsTest, euclideanDistance, bestHyperParams.second, config);
-            pair<vector<unsigned int>, unsigned int> scoreTraining = getScoreKNN(bestHyperParams.first, dataTraining, dataTraining, labelsTraining, labelsTraining, euclideanDistance, bestHyperParams.second, config);
-            end = MPI_Wtime();
-            cout << "Time KNN: " << end - start << endl;
-
-            // 5. Get Confusion Matrix for test
-            vector<vector<unsigned int>> confusionMatrixTest = getConfusionMatrix(labelsTest, scoreTest.first, config.nClasses);
-            cout << "Confusion Matrix Test: " << endl;
-            printMatrix(confusionMatrixTest);
-
-            cout << "Accuracy of K-NN classifier on training set: " << ((float)scoreTraining.second / (float)config.nTuples) << endl;
-            cout << "Accuracy of K-NN classifier on test set: " << ((float)scoreTest.second / (float)config.nTuples) << endl;
+            // A dead slave would block the collectives of the report and of MPI_Finalize
+            if (lostSlaves) {
+                fprintf(stderr, "%s\n", WARNING_LOST_SLAVES);
+                MPI_Abort(MPI_COMM_WORLD, EXIT_SUCCESS);
+            }
+
+            // 6. Report the energy of each phase aggregated across all the processes
+            if (config.measureEnergy && config.mode != "serve") {
+                counter.report(cout, 2 * config.nTuples);
+            }
+
+            // The thread of the price feed waits for the next fetch, wake it up to join the region
+            saving.stop();
         }
     }
     MPI_Finalize();
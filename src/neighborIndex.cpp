@@ -0,0 +1,79 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file neighborIndex.cpp
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Implementation of the selection of the index of the nearest neighbors
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+/********************************* Includes *******************************/
+#include "neighborIndex.h"
+
+#include "hammingFilter.h"
+#include "hnsw.h"
+#include "ivfpq.h"
+#include "kdTree.h"
+#include "laesa.h"
+#include "lsh.h"
+#include "quantizedScan.h"
+#include "vpTree.h"
+
+/******************************** Constants *******************************/
+
+/********************************* Methods ********************************/
+std::vector<std::pair<float, unsigned int>> NeighborIndex::getNeighbors(std::vector<float>& dataTest, unsigned int ptrDataTest, unsigned int k) const {
+    std::vector<std::pair<float, unsigned int>> neighbors = this->getNearestTuples(dataTest, ptrDataTest, k);
+    for (auto& neighbor : neighbors) {
+        neighbor.second = this->labelsTraining[neighbor.second];
+    }
+
+    return neighbors;
+}
+
+NeighborIndex* createNeighborIndex(std::vector<float>& dataTraining,
+                                   std::vector<unsigned int>& labelsTraining,
+                                   float (*distanceFunction)(std::vector<float>&,
+                                                             std::vector<float>&,
+                                                             unsigned int,
+                                                             unsigned int,
+                                                             unsigned int),
+                                   unsigned int nFeatures,
+                                   const Config& config) {
+    // The kd-tree prunes less as the dimension grows, with many features the full scan is faster
+    if (config.knnIndex == "kdtree" || (config.knnIndex == "auto" && nFeatures <= config.kdTreeMaxFeatures)) {
+        return new KDTree(dataTraining, labelsTraining, distanceFunction, nFeatures, config);
+    }
+    if (config.knnIndex == "hnsw") {
+        return new HNSW(dataTraining, labelsTraining, distanceFunction, nFeatures, config);
+    }
+    if (config.knnIndex == "ivfpq") {
+        return new IVFPQ(dataTraining, labelsTraining, distanceFunction, nFeatures, config);
+    }
+    if (config.knnIndex == "laesa") {
+        return new LAESA(dataTraining, labelsTraining, distanceFunction, nFeatures, config);
+    }
+    if (config.knnIndex == "hamming") {
+        return new HammingFilter(dataTraining, labelsTraining, distanceFunction, nFeatures, config);
+    }
+    if (config.knnIndex == "int8") {
+        return new QuantizedScan(dataTraining, labelsTraining, distanceFunction, nFeatures, config);
+    }
+    if (config.knnIndex == "lsh") {
+        return new LSH(dataTraining, labelsTraining, distanceFunction, nFeatures, config);
+    }
+    if (config.knnIndex == "vptree") {
+        return new VPTree(dataTraining, labelsTraining, distanceFunction, nFeatures, config);
+    }
+
+    return NULL;
+}
@@ -0,0 +1,172 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file numaPlacement.cpp
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Implementation of the placement of the training data and the threads in the NUMA nodes
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+/********************************* Includes *******************************/
+#include "numaPlacement.h"
+
+#include <linux/mempolicy.h>
+#include <mpi.h>
+#include <omp.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+/******************************** Constants *******************************/
+
+/******************************** Structures ******************************/
+static std::vector<std::vector<float>> replicas; /**< Copy of the training data in each node, empty without replicate */
+static const float* replicated = NULL;           /**< Values of the training data replicated */
+static std::vector<int> nodeOfCpu;               /**< Node of each CPU */
+
+/********************************* Methods ********************************/
+
+/**
+ * @brief Parse a list of CPUs or nodes of Linux, as 0-3,8,10-11
+ * @param list The list
+ * @return The numbers of the list
+ */
+static std::vector<int> parseList(const std::string& list) {
+    std::vector<int> numbers;
+    std::stringstream stream(list);
+    std::string range;
+    while (std::getline(stream, range, ',')) {
+        if (range.empty() || range == "\n") {
+            continue;
+        }
+        size_t dash = range.find('-');
+        int first = std::stoi(range.substr(0, dash));
+        int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+        for (int n = first; n <= last; ++n) {
+            numbers.push_back(n);
+        }
+    }
+
+    return numbers;
+}
+
+/**
+ * @brief Read the first line of a file of the system
+ * @param filename The name of the file
+ * @return The line, empty if the file cannot be read
+ */
+static std::string readLine(const std::string& filename) {
+    std::ifstream file(filename.c_str());
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+void placeNuma(std::ostream& os, std::vector<float>& dataTraining, const Config& config) {
+    if (config.numa == "none") {
+        return;
+    }
+
+    // The CPUs of each node, a single node when the system does not tell them
+    std::vector<int> nodes = parseList(readLine(std::string(NUMA_NODES_PATH) + "/online"));
+    if (nodes.empty()) {
+        nodes.push_back(0);
+    }
+    std::vector<std::vector<int>> cpusOfNode(nodes.size());
+    for (unsigned int n = 0; n < nodes.size(); ++n) {
+        cpusOfNode[n] = parseList(readLine(std::string(NUMA_NODES_PATH) + "/node" + std::to_string(nodes[n]) + "/cpulist"));
+        for (int cpu : cpusOfNode[n]) {
+            if (cpu >= (int)nodeOfCpu.size()) {
+                nodeOfCpu.resize(cpu + 1, 0);
+            }
+            nodeOfCpu[cpu] = n;
+        }
+    }
+
+    // Each node gets a block of consecutive threads, and the first thread of a node makes its replica
+    unsigned int nThreads = omp_get_max_threads();
+    std::vector<int> cpuOfThread(nThreads, -1);
+    if (config.numa == "replicate" && nodes.size() > 1) {
+        replicas.assign(nodes.size(), std::vector<float>());
+        replicated = dataTraining.data();
+    }
+#pragma omp parallel num_threads(nThreads)
+    {
+        unsigned int thread = omp_get_thread_num();
+        unsigned int node = thread * nodes.size() / nThreads;
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        for (int cpu : cpusOfNode[node]) {
+            CPU_SET(cpu, &cpus);
+        }
+        if (!cpusOfNode[node].empty()) {
+            sched_setaffinity(0, sizeof(cpus), &cpus);
+        }
+        cpuOfThread[thread] = sched_getcpu();
+        if (!replicas.empty() && thread == (node * nThreads + nodes.size() - 1) / nodes.size()) {
+            replicas[node].assign(dataTraining.begin(), dataTraining.end());
+        }
+    }
+
+    bool interleaved = false;
+    if (config.numa == "interleave" && nodes.size() > 1) {
+        // The pages already touched are moved, the first and last ones can be shared with other data
+        unsigned long mask = 0;
+        for (int node : nodes) {
+            mask |= 1UL << node;
+        }
+        long pageSize = sysconf(_SC_PAGESIZE);
+        unsigned long first = ((unsigned long)dataTraining.data() + pageSize - 1) / pageSize * pageSize;
+        unsigned long last = (unsigned long)(dataTraining.data() + dataTraining.size()) / pageSize * pageSize;
+        interleaved = last > first && !syscall(SYS_mbind, first, last - first, MPOL_INTERLEAVE, &mask, sizeof(mask) * 8, MPOL_MF_MOVE);
+    }
+
+    /************ Report the placement ***********/
+    std::stringstream report;
+    report << "Process " << MPI::COMM_WORLD.Get_rank() << ": NUMA " << config.numa << " with " << nodes.size() << " nodes" << std::endl;
+    for (unsigned int n = 0; n < nodes.size(); ++n) {
+        report << "  Node " << nodes[n] << ": " << cpusOfNode[n].size() << " CPUs, threads";
+        for (unsigned int t = 0; t < nThreads; ++t) {
+            if (t * nodes.size() / nThreads == n) {
+                report << " " << t << "(cpu " << cpuOfThread[t] << ")";
+            }
+        }
+        if (!replicas.empty()) {
+            report << ", replica of " << replicas[n].size() * sizeof(float) / (1024.0 * 1024.0) << " MB";
+        }
+        report << std::endl;
+    }
+    if (config.numa == "interleave") {
+        report << "  Training data " << (interleaved ? "interleaved" : "not interleaved") << " over the nodes" << std::endl;
+    }
+    if (nodes.size() == 1) {
+        report << "  A single node, the training data is not moved" << std::endl;
+    }
+    os << report.str();
+}
+
+std::vector<float>& getNumaLocalData(std::vector<float>& data) {
+    if (replicas.empty() || data.data() != replicated) {
+        return data;
+    }
+
+    int cpu = sched_getcpu();
+    if (cpu < 0 || cpu >= (int)nodeOfCpu.size() || replicas[nodeOfCpu[cpu]].empty()) {
+        return data;
+    }
+
+    return replicas[nodeOfCpu[cpu]];
+}
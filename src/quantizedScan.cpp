@@ -0,0 +1,214 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file quantizedScan.cpp
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Implementation of the scan of the training data quantized to 8 bits
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+/********************************* Includes *******************************/
+#include "quantizedScan.h"
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+
+#include "knn.h"
+
+/******************************** Constants *******************************/
+
+/********************************* Methods ********************************/
+
+/**
+ * @brief Get the squared euclidean distance between two codes
+ * @param a The first code
+ * @param b The second code
+ * @param n The number of bytes
+ * @return The sum of the squared differences
+ */
+static uint32_t squaredDistanceScalar(const uint8_t* a, const uint8_t* b, unsigned int n) {
+    uint32_t distance = 0;
+    for (unsigned int i = 0; i < n; ++i) {
+        int difference = (int)a[i] - (int)b[i];
+        distance += difference * difference;
+    }
+    return distance;
+}
+
+/**
+ * @brief Get the squared euclidean distance between two codes with AVX2, the differences in 16
+ * bits are squared and added in pairs to 32 bits by pmaddwd
+ * @param a The first code, aligned
+ * @param b The second code, aligned
+ * @param n The number of bytes, a multiple of 16
+ * @return The sum of the squared differences
+ */
+__attribute__((target("avx2"))) static uint32_t squaredDistanceAVX2(const uint8_t* a, const uint8_t* b, unsigned int n) {
+    __m256i sum = _mm256_setzero_si256();
+    for (unsigned int i = 0; i < n; i += 16) {
+        __m256i difference = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_load_si128((const __m128i*)(a + i))),
+                                              _mm256_cvtepu8_epi16(_mm_load_si128((const __m128i*)(b + i))));
+        sum = _mm256_add_epi32(sum, _mm256_madd_epi16(difference, difference));
+    }
+    __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0x4e));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0xb1));
+    return _mm_cvtsi128_si32(half);
+}
+
+/**
+ * @brief Get the squared euclidean distance between two codes with AVX-512 VNNI, vpdpwssd squares
+ * the differences in 16 bits and accumulates them in 32 bits in one instruction
+ * @param a The first code, aligned
+ * @param b The second code, aligned
+ * @param n The number of bytes, a multiple of 32
+ * @return The sum of the squared differences
+ */
+__attribute__((target("avx512f,avx512bw,avx512vnni"))) static uint32_t squaredDistanceVNNI(const uint8_t* a, const uint8_t* b, unsigned int n) {
+    __m512i sum = _mm512_setzero_si512();
+    for (unsigned int i = 0; i < n; i += 32) {
+        __m512i difference = _mm512_sub_epi16(_mm512_cvtepu8_epi16(_mm256_load_si256((const __m256i*)(a + i))),
+                                              _mm512_cvtepu8_epi16(_mm256_load_si256((const __m256i*)(b + i))));
+        sum = _mm512_dpwssd_epi32(sum, difference, difference);
+    }
+    return _mm512_reduce_add_epi32(sum);
+}
+
+/**
+ * @brief Get the manhattan distance between two codes
+ * @param a The first code
+ * @param b The second code
+ * @param n The number of bytes
+ * @return The sum of the absolute differences
+ */
+static uint32_t manhattanDistanceScalar(const uint8_t* a, const uint8_t* b, unsigned int n) {
+    uint32_t distance = 0;
+    for (unsigned int i = 0; i < n; ++i) {
+        distance += a[i] > b[i] ? a[i] - b[i] : b[i] - a[i];
+    }
+    return distance;
+}
+
+/**
+ * @brief Get the manhattan distance between two codes with AVX2, psadbw adds the absolute
+ * differences of 8 bytes in 64 bits
+ * @param a The first code, aligned
+ * @param b The second code, aligned
+ * @param n The number of bytes, a multiple of 32
+ * @return The sum of the absolute differences
+ */
+__attribute__((target("avx2"))) static uint32_t manhattanDistanceAVX2(const uint8_t* a, const uint8_t* b, unsigned int n) {
+    __m256i sum = _mm256_setzero_si256();
+    for (unsigned int i = 0; i < n; i += 32) {
+        sum = _mm256_add_epi64(sum, _mm256_sad_epu8(_mm256_load_si256((const __m256i*)(a + i)), _mm256_load_si256((const __m256i*)(b + i))));
+    }
+    __m128i half = _mm_add_epi64(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    return _mm_cvtsi128_si64(_mm_add_epi64(half, _mm_unpackhi_epi64(half, half)));
+}
+
+QuantizedScan::QuantizedScan(std::vector<float>& dataTraining,
+                             std::vector<unsigned int>& labelsTraining,
+                             float (*distanceFunction)(std::vector<float>&,
+                                                       std::vector<float>&,
+                                                       unsigned int,
+                                                       unsigned int,
+                                                       unsigned int),
+                             unsigned int nFeatures,
+                             const Config& config)
+    : NeighborIndex(labelsTraining),
+      dataTraining(dataTraining),
+      distanceFunction(distanceFunction),
+      nFeatures(nFeatures),
+      stride(config.nFeatures),
+      codeStride((nFeatures + MEMORY_ALIGNMENT - 1) / MEMORY_ALIGNMENT * MEMORY_ALIGNMENT),
+      nRerank(config.int8Rerank),
+      squared(distanceFunction != manhattanDistance),
+      minValue(0),
+      scale(1) {
+    unsigned int nTuples = dataTraining.size() / config.nFeatures;
+
+    // The range of the features used gives the scale, the same for all of them
+    float maxValue = -INFINITY;
+    this->minValue = INFINITY;
+    for (unsigned int i = 0; i < nTuples; ++i) {
+        for (unsigned int f = 0; f < nFeatures; ++f) {
+            this->minValue = std::min(this->minValue, dataTraining[i * this->stride + f]);
+            maxValue = std::max(maxValue, dataTraining[i * this->stride + f]);
+        }
+    }
+    if (maxValue > this->minValue) {
+        this->scale = (maxValue - this->minValue) / QUANTIZED_LEVELS;
+    } else {
+        this->minValue = 0;
+    }
+
+    // The padding is zero in the tuples and in the queries, so it adds nothing to a distance
+    this->codes.assign((size_t)nTuples * this->codeStride, 0);
+#pragma omp parallel for
+    for (unsigned int i = 0; i < nTuples; ++i) {
+        for (unsigned int f = 0; f < nFeatures; ++f) {
+            float code = std::round((dataTraining[i * this->stride + f] - this->minValue) / this->scale);
+            this->codes[(size_t)i * this->codeStride + f] = std::min(std::max(code, 0.0f), (float)QUANTIZED_LEVELS);
+        }
+    }
+
+    if (this->squared) {
+        this->kernel = __builtin_cpu_supports("avx512vnni") && __builtin_cpu_supports("avx512bw") ? squaredDistanceVNNI
+                       : __builtin_cpu_supports("avx2")                                            ? squaredDistanceAVX2
+                                                                                                   : squaredDistanceScalar;
+    } else {
+        this->kernel = __builtin_cpu_supports("avx2") ? manhattanDistanceAVX2 : manhattanDistanceScalar;
+    }
+}
+
+std::vector<std::pair<float, unsigned int>> QuantizedScan::getNearestTuples(std::vector<float>& dataTest, unsigned int ptrDataTest, unsigned int k) const {
+    unsigned int nTuples = this->labelsTraining.size();
+    std::vector<uint8_t, AlignedAllocator<uint8_t>> query(this->codeStride, 0);
+    for (unsigned int f = 0; f < this->nFeatures; ++f) {
+        float code = std::round((dataTest[ptrDataTest + f] - this->minValue) / this->scale);
+        query[f] = std::min(std::max(code, 0.0f), (float)QUANTIZED_LEVELS);
+    }
+
+    // The best candidates by the distance between the codes, the ties in the order of the training data
+    unsigned int nCandidates = std::max(k, this->nRerank);
+    std::priority_queue<std::pair<uint32_t, unsigned int>> heap;
+    for (unsigned int i = 0; i < nTuples; ++i) {
+        std::pair<uint32_t, unsigned int> candidate(this->kernel(&this->codes[(size_t)i * this->codeStride], query.data(), this->codeStride), i);
+        if (heap.size() < nCandidates) {
+            heap.push(candidate);
+        } else if (candidate < heap.top()) {
+            heap.pop();
+            heap.push(candidate);
+        }
+    }
+
+    std::vector<std::pair<float, unsigned int>> neighbors;
+    neighbors.reserve(heap.size());
+    while (!heap.empty()) {
+        unsigned int i = heap.top().second;
+        float distance = this->nRerank ? this->distanceFunction(this->dataTraining, dataTest, i * this->stride, ptrDataTest, this->nFeatures)
+                         : this->squared ? std::sqrt((float)heap.top().first) * this->scale
+                                         : heap.top().first * this->scale;
+        neighbors.push_back(std::make_pair(distance, i));
+        heap.pop();
+    }
+
+    std::sort(neighbors.begin(), neighbors.end());
+    if (neighbors.size() > k) {
+        neighbors.resize(k);
+    }
+
+    return neighbors;
+}
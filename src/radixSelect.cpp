@@ -0,0 +1,236 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file radixSelect.cpp
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Implementation of the radix selection of the nearest distances packed in 64-bit keys
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+/********************************* Includes *******************************/
+#include "radixSelect.h"
+
+#include <immintrin.h>
+
+#include <algorithm>
+
+/******************************** Constants *******************************/
+const unsigned int KEY_BITS = 64; /**< Bits of a key */
+
+/********************************* Methods ********************************/
+
+/**
+ * @brief Sort N keys by a bitonic network, each compare and exchange without branches
+ * @param keys The keys
+ */
+template <unsigned int N>
+static void sortingNetworkScalar(uint64_t* keys) {
+    for (unsigned int k = 2; k <= N; k <<= 1) {
+        for (unsigned int j = k >> 1; j > 0; j >>= 1) {
+            for (unsigned int i = 0; i < N / 2; ++i) {
+                unsigned int low = ((i & ~(j - 1)) << 1) | (i & (j - 1));
+                uint64_t a = keys[low], b = keys[low + j];
+                bool exchange = (a > b) == ((low & k) == 0);
+                keys[low] = exchange ? b : a;
+                keys[low + j] = exchange ? a : b;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Sort N keys by a bitonic network with AVX-512, 8 keys in each register and all of them
+ * loaded in registers while the network runs. The pairs that are 8 or more apart are compared
+ * between two registers, the nearer ones inside a register with a permutation, with a mask that
+ * picks the minimum or the maximum in each lane
+ * @param keys The keys
+ */
+template <unsigned int N>
+__attribute__((target("avx512f"))) static void sortingNetworkAVX512(uint64_t* keys) {
+    const unsigned int nRegisters = N / 8;
+    const __m512i lanes = _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m512i partners[3] = {_mm512_xor_si512(lanes, _mm512_set1_epi64(4)),
+                                 _mm512_xor_si512(lanes, _mm512_set1_epi64(2)),
+                                 _mm512_xor_si512(lanes, _mm512_set1_epi64(1))};
+    const __mmask8 low[3] = {0x0F, 0x33, 0x55};
+
+    __m512i registers[nRegisters];
+#pragma GCC unroll 64
+    for (unsigned int r = 0; r < nRegisters; ++r) {
+        registers[r] = _mm512_loadu_si512(keys + r * 8);
+    }
+
+#pragma GCC unroll 16
+    for (unsigned int k = 2; k <= N; k <<= 1) {
+#pragma GCC unroll 16
+        for (unsigned int j = k >> 4; j > 0; j >>= 1) {
+#pragma GCC unroll 64
+            for (unsigned int i = 0; i < nRegisters / 2; ++i) {
+                unsigned int first = ((i & ~(j - 1)) << 1) | (i & (j - 1));
+                __m512i minimum = _mm512_min_epu64(registers[first], registers[first + j]);
+                __m512i maximum = _mm512_max_epu64(registers[first], registers[first + j]);
+                bool ascending = ((first * 8) & k) == 0;
+                registers[first] = ascending ? minimum : maximum;
+                registers[first + j] = ascending ? maximum : minimum;
+            }
+        }
+
+        // The steps of 4, 2 and 1 of this k inside each register
+        unsigned int firstStep = k >= 8 ? 0 : (k == 4 ? 1 : 2);
+#pragma GCC unroll 64
+        for (unsigned int r = 0; r < nRegisters; ++r) {
+            __mmask8 descending = _mm512_test_epi64_mask(_mm512_add_epi64(lanes, _mm512_set1_epi64(r * 8)), _mm512_set1_epi64(k));
+#pragma GCC unroll 3
+            for (unsigned int step = firstStep; step < 3; ++step) {
+                __m512i partner = _mm512_permutexvar_epi64(partners[step], registers[r]);
+                __m512i minimum = _mm512_min_epu64(registers[r], partner), maximum = _mm512_max_epu64(registers[r], partner);
+                registers[r] = _mm512_mask_blend_epi64(low[step] ^ descending, maximum, minimum);
+            }
+        }
+    }
+
+#pragma GCC unroll 64
+    for (unsigned int r = 0; r < nRegisters; ++r) {
+        _mm512_storeu_si512(keys + r * 8, registers[r]);
+    }
+}
+
+/**
+ * @brief Sort N keys by the bitonic network of the CPU
+ * @param keys The keys
+ */
+template <unsigned int N>
+static void sortingNetwork(uint64_t* keys) {
+    static const bool avx512 = __builtin_cpu_supports("avx512f");
+    if (avx512) {
+        sortingNetworkAVX512<N>(keys);
+    } else {
+        sortingNetworkScalar<N>(keys);
+    }
+}
+
+/**
+ * @brief Sort up to SORTING_NETWORK_MAX keys by the smallest network that fits them, padded with
+ * the largest key
+ * @param keys The keys
+ */
+static void sortKeysByNetwork(std::vector<uint64_t>& keys) {
+    size_t n = keys.size();
+    unsigned int size = SORTING_NETWORK_MIN;
+    while (size < n) {
+        size <<= 1;
+    }
+
+    keys.resize(size, UINT64_MAX);
+    switch (size) {
+        case 64:
+            sortingNetwork<64>(keys.data());
+            break;
+        case 128:
+            sortingNetwork<128>(keys.data());
+            break;
+        case 256:
+            sortingNetwork<256>(keys.data());
+            break;
+        default:
+            sortingNetwork<512>(keys.data());
+            break;
+    }
+    keys.resize(n);
+}
+
+/**
+ * @brief Sort the keys by least significant digit passes, skipping the digits that all the keys share
+ * @param keys The keys
+ * @param scratch Memory reused between calls
+ */
+static void radixSortKeys(std::vector<uint64_t>& keys, std::vector<uint64_t>& scratch) {
+    size_t n = keys.size();
+    if (n >= SORTING_NETWORK_FROM && n <= SORTING_NETWORK_MAX) {
+        sortKeysByNetwork(keys);
+        return;
+    }
+    if (n < RADIX_SORT_MIN) {
+        std::sort(keys.begin(), keys.end());
+        return;
+    }
+
+    scratch.resize(n);
+    for (unsigned int shift = 0; shift < KEY_BITS; shift += RADIX_BITS) {
+        size_t counts[RADIX_BUCKETS] = {0};
+        for (size_t i = 0; i < n; ++i) {
+            counts[(keys[i] >> shift) & (RADIX_BUCKETS - 1)]++;
+        }
+        if (counts[(keys[0] >> shift) & (RADIX_BUCKETS - 1)] == n) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (unsigned int b = 0; b < RADIX_BUCKETS; ++b) {
+            size_t count = counts[b];
+            counts[b] = offset;
+            offset += count;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            scratch[counts[(keys[i] >> shift) & (RADIX_BUCKETS - 1)]++] = keys[i];
+        }
+        keys.swap(scratch);
+    }
+}
+
+void selectSmallestKeys(std::vector<uint64_t>& keys, size_t k, std::vector<uint64_t>& scratch) {
+    size_t n = keys.size();
+    if (n >= SORTING_NETWORK_FROM && n <= SORTING_NETWORK_MAX) {
+        // The network sorts them all in less time than the passes select
+        sortKeysByNetwork(keys);
+        keys.resize(std::min(k, n));
+        return;
+    }
+
+    if (k < n && k > 0) {
+        // The bucket of the k-th key in each digit, from the most significant, keeping only its keys
+        scratch.assign(keys.begin(), keys.end());
+        size_t nCandidates = n, rank = k - 1;
+        for (int shift = KEY_BITS - RADIX_BITS; shift >= 0 && nCandidates > 1; shift -= RADIX_BITS) {
+            size_t counts[RADIX_BUCKETS] = {0};
+            for (size_t i = 0; i < nCandidates; ++i) {
+                counts[(scratch[i] >> shift) & (RADIX_BUCKETS - 1)]++;
+            }
+            unsigned int bucket = 0;
+            while (rank >= counts[bucket]) {
+                rank -= counts[bucket++];
+            }
+
+            size_t kept = 0;
+            for (size_t i = 0; i < nCandidates; ++i) {
+                scratch[kept] = scratch[i];
+                kept += ((scratch[i] >> shift) & (RADIX_BUCKETS - 1)) == bucket;
+            }
+            nCandidates = kept;
+        }
+
+        // The keys are different, so exactly k are not larger than the k-th
+        uint64_t kthKey = scratch[0];
+        size_t kept = 0;
+        for (size_t i = 0; i < n; ++i) {
+            uint64_t key = keys[i];
+            keys[kept] = key;
+            kept += key <= kthKey;
+        }
+        keys.resize(kept);
+    }
+
+    if (k == 0) {
+        keys.clear();
+    }
+    radixSortKeys(keys, scratch);
+}
@@ -0,0 +1,264 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file server.cpp
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Implementation of the classification server
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+/********************************* Includes *******************************/
+#include "server.h"
+
+#include <fcntl.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <new>
+#include <thread>
+
+#include "knn.h"
+#include "shmRing.h"
+
+/******************************** Constants *******************************/
+
+/********************************* Methods ********************************/
+/**
+ * @brief Read exactly len bytes from a socket
+ * @param fd The socket
+ * @param buffer Where the bytes are stored
+ * @param len Number of bytes
+ * @return true if success, false if the connection is closed or failed
+ */
+static bool readAll(int fd, void* buffer, size_t len) {
+    char* ptr = (char*)buffer;
+    while (len > 0) {
+        ssize_t n = read(fd, ptr, len);
+        if (n <= 0) {
+            return false;
+        }
+        ptr += n;
+        len -= n;
+    }
+    return true;
+}
+
+/**
+ * @brief Write exactly len bytes to a socket
+ * @param fd The socket
+ * @param buffer The bytes to write
+ * @param len Number of bytes
+ * @return true if success, false if the connection is closed or failed
+ */
+static bool writeAll(int fd, const void* buffer, size_t len) {
+    const char* ptr = (const char*)buffer;
+    while (len > 0) {
+        ssize_t n = write(fd, ptr, len);
+        if (n <= 0) {
+            return false;
+        }
+        ptr += n;
+        len -= n;
+    }
+    return true;
+}
+
+KNNServer::KNNServer(const Config& config, std::vector<float>& dataTraining, std::vector<unsigned int>& labelsTraining, float minValue, float maxValue)
+    : config(config), dataTraining(dataTraining), labelsTraining(labelsTraining), minValue(minValue), maxValue(maxValue) {
+    check(!config.serveK || !config.serveNFeatures || config.serveNFeatures > config.nFeatures, "%s\n", ERROR_SERVE_PARAMS);
+    this->index.reset(createNeighborIndex(dataTraining, labelsTraining, euclideanDistance, config.serveNFeatures, config));
+
+    // An index that answers without the training data, like IVF-PQ without re-rank, is all the memory of the server
+    if (this->index && !this->index->usesTrainingData()) {
+        std::cout << "Index " << config.knnIndex << " answers without the training data, " << dataTraining.size() * sizeof(float) / (1024.0 * 1024.0) << " MB freed" << std::endl;
+        std::vector<float>().swap(dataTraining);
+    }
+}
+
+void KNNServer::run() {
+    // A client that closes the connection must not kill the server
+    signal(SIGPIPE, SIG_IGN);
+
+    int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, this->config.serveSocket.c_str(), sizeof(address.sun_path) - 1);
+    unlink(address.sun_path);
+
+    check(sock < 0 || bind(sock, (struct sockaddr*)&address, sizeof(address)) || listen(sock, SOMAXCONN), "%s\n", ERROR_SERVE_SOCKET);
+    std::cout << "Serving k = " << this->config.serveK << " with " << this->config.serveNFeatures << " features in " << this->config.serveSocket << std::endl;
+
+    std::thread(&KNNServer::batcher, this).detach();
+    if (!this->config.serveShm.empty()) {
+        std::thread(&KNNServer::shmServe, this).detach();
+    }
+
+    while (true) {
+        int client = accept(sock, NULL, NULL);
+        if (client >= 0) {
+            std::thread(&KNNServer::handleClient, this, client).detach();
+        }
+    }
+}
+
+void KNNServer::handleClient(int client) {
+    ServeHeader header;
+    float range = this->maxValue - this->minValue;
+
+    while (readAll(client, &header, sizeof(header))) {
+        if (header.nFeatures != this->config.serveNFeatures || !header.nVectors) {
+            std::cerr << "Client sent " << header.nFeatures << " features, expected " << this->config.serveNFeatures << std::endl;
+            break;
+        }
+
+        // The size of the frame is checked before allocating anything for it
+        if (header.nVectors > this->config.serveMaxFrameVectors) {
+            std::cerr << "Client sent " << header.nVectors << " vectors, at most " << this->config.serveMaxFrameVectors << " are accepted" << std::endl;
+            break;
+        }
+
+        Request request;
+        request.nVectors = header.nVectors;
+        request.features.resize((size_t)header.nVectors * header.nFeatures);
+        if (!readAll(client, request.features.data(), request.features.size() * sizeof(float))) {
+            break;
+        }
+
+        // The queries are normalized like the training data
+        if (this->config.normalize) {
+            for (float& value : request.features) {
+                value = (value - this->minValue) / range;
+            }
+        }
+
+        std::future<std::vector<unsigned int>> labels = request.labels.get_future();
+        {
+            std::lock_guard<std::mutex> guard(this->mutex);
+            this->queue.push_back(&request);
+        }
+        this->ready.notify_one();
+
+        std::vector<unsigned int> predicted = labels.get();
+        std::vector<uint32_t> response(predicted.begin(), predicted.end());
+        if (!writeAll(client, response.data(), response.size() * sizeof(uint32_t))) {
+            break;
+        }
+    }
+
+    close(client);
+}
+
+void KNNServer::batcher() {
+    std::vector<float> queries;
+    std::vector<Request*> batch;
+
+    while (true) {
+        batch.clear();
+        queries.clear();
+        unsigned int nQueries = 0;
+
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->ready.wait(lock, [this] { return !this->queue.empty(); });
+
+            // Wait a little for more requests if the batch is not full
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(this->config.serveBatchWaitUs);
+            while (true) {
+                while (!this->queue.empty() && (batch.empty() || nQueries + this->queue.front()->nVectors <= this->config.serveBatchSize)) {
+                    batch.push_back(this->queue.front());
+                    nQueries += this->queue.front()->nVectors;
+                    this->queue.pop_front();
+                }
+                if (nQueries >= this->config.serveBatchSize || !this->queue.empty() ||
+                    !this->ready.wait_until(lock, deadline, [this] { return !this->queue.empty(); })) {
+                    break;
+                }
+            }
+        }
+
+        for (Request* request : batch) {
+            queries.insert(queries.end(), request->features.begin(), request->features.end());
+        }
+
+        std::vector<unsigned int> labels = KNNBatch(this->config.serveK, this->dataTraining, this->labelsTraining, euclideanDistance, queries, nQueries, this->config.serveNFeatures, this->config, this->index.get());
+
+        unsigned int offset = 0;
+        for (Request* request : batch) {
+            request->labels.set_value(std::vector<unsigned int>(labels.begin() + offset, labels.begin() + offset + request->nVectors));
+            offset += request->nVectors;
+        }
+    }
+}
+
+void KNNServer::shmServe() {
+    unsigned int nSlots = this->config.serveShmSlots;
+    check(!nSlots || (nSlots & (nSlots - 1)), "%s\n", ERROR_SERVE_SHM);
+
+    // A ring left by a previous server is replaced
+    shm_unlink(this->config.serveShm.c_str());
+    size_t size = shmRingSize(this->config.serveNFeatures, nSlots);
+    int fd = shm_open(this->config.serveShm.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    check(fd < 0 || ftruncate(fd, size), "%s\n", ERROR_SERVE_SHM);
+    void* ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    check(ptr == MAP_FAILED, "%s\n", ERROR_SERVE_SHM);
+    close(fd);
+
+    ShmRingHeader* ring = new (ptr) ShmRingHeader;
+    ring->nFeatures = this->config.serveNFeatures;
+    ring->nSlots = nSlots;
+    ring->slotSize = shmSlotSize(ring->nFeatures);
+    ring->head.store(0, std::memory_order_relaxed);
+    ring->done.store(0, std::memory_order_relaxed);
+    ring->magic.store(SHM_RING_MAGIC, std::memory_order_release);
+    std::cout << "Serving in the shared memory " << this->config.serveShm << " with " << nSlots << " slots" << std::endl;
+
+    float range = this->maxValue - this->minValue;
+    std::vector<float> queries;
+    unsigned int idlePolls = 0;
+
+    while (true) {
+        uint64_t done = ring->done.load(std::memory_order_relaxed);
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        if (head == done) {
+            // Spin while the client is active, sleep when it is idle
+            if (++idlePolls >= SHM_SPIN_POLLS) {
+                usleep(SHM_IDLE_US);
+            }
+            continue;
+        }
+        idlePolls = 0;
+
+        unsigned int nQueries = std::min<uint64_t>(head - done, this->config.serveBatchSize);
+        queries.resize((size_t)nQueries * ring->nFeatures);
+        for (unsigned int q = 0; q < nQueries; ++q) {
+            const float* features = shmSlotFeatures(ring, done + q);
+            for (unsigned int f = 0; f < ring->nFeatures; ++f) {
+                queries[q * ring->nFeatures + f] = this->config.normalize ? (features[f] - this->minValue) / range : features[f];
+            }
+        }
+
+        std::vector<unsigned int> labels = KNNBatch(this->config.serveK, this->dataTraining, this->labelsTraining, euclideanDistance, queries, nQueries, this->config.serveNFeatures, this->config, this->index.get());
+
+        for (unsigned int q = 0; q < nQueries; ++q) {
+            *shmSlotLabel(ring, done + q) = labels[q];
+        }
+        ring->done.store(done + nQueries, std::memory_order_release);
+    }
+}
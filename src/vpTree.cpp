@@ -0,0 +1,140 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file vpTree.cpp
+ * @author Francisco Rodríguez Jiménez
+ * @date 18/10/2026
+ * @brief Implementation of the vantage-point tree
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+/********************************* Includes *******************************/
+#include "vpTree.h"
+
+#include <algorithm>
+
+/******************************** Constants *******************************/
+
+/********************************* Methods ********************************/
+VPTree::VPTree(std::vector<float>& dataTraining,
+               std::vector<unsigned int>& labelsTraining,
+               float (*distanceFunction)(std::vector<float>&,
+                                         std::vector<float>&,
+                                         unsigned int,
+                                         unsigned int,
+                                         unsigned int),
+               unsigned int nFeatures,
+               const Config& config)
+    : NeighborIndex(labelsTraining), distanceFunction(distanceFunction), nFeatures(nFeatures) {
+    unsigned int nTuples = dataTraining.size() / config.nFeatures;
+    std::vector<std::pair<float, unsigned int>> tuples(nTuples);
+    for (unsigned int i = 0; i < nTuples; ++i) {
+        tuples[i] = std::make_pair(0.0f, i);
+    }
+
+    // Every node has at least one tuple, so there are at most nTuples nodes
+    this->nodes.resize(nTuples);
+    unsigned int nNodes = 1;
+    if (nTuples) {
+#pragma omp parallel
+#pragma omp single
+        this->build(dataTraining, tuples, 0, nTuples, 0, nNodes, config);
+    }
+    this->nodes.resize(std::min(nNodes, nTuples));
+
+    // The tuples of each node are contiguous so the search reads them in order
+    this->indexes.resize(nTuples);
+    this->points.resize((size_t)nTuples * nFeatures);
+    for (unsigned int i = 0; i < nTuples; ++i) {
+        this->indexes[i] = tuples[i].second;
+        std::copy_n(dataTraining.begin() + (size_t)tuples[i].second * config.nFeatures, nFeatures, this->points.begin() + (size_t)i * nFeatures);
+    }
+}
+
+void VPTree::build(std::vector<float>& dataTraining, std::vector<std::pair<float, unsigned int>>& tuples, unsigned int begin, unsigned int end, unsigned int node, unsigned int& nNodes, const Config& config) {
+    this->nodes[node] = Node{begin, end, true, 0, 0, 0};
+    if (end - begin <= VPTREE_LEAF_SIZE) {
+        return;
+    }
+
+    // The vantage point is chosen pseudo-randomly, but always the same for the same data
+    std::swap(tuples[begin], tuples[begin + (unsigned int)((begin * 2654435761UL + end) % (end - begin))]);
+    unsigned int vantage = tuples[begin].second;
+    for (unsigned int i = begin + 1; i < end; ++i) {
+        tuples[i].first = this->distanceFunction(dataTraining, dataTraining, vantage * config.nFeatures, tuples[i].second * config.nFeatures, this->nFeatures);
+    }
+
+    unsigned int middle = begin + 1 + (end - begin - 1) / 2;
+    std::nth_element(tuples.begin() + begin + 1, tuples.begin() + middle, tuples.begin() + end);
+
+    unsigned int inner;
+#pragma omp atomic capture
+    {
+        inner = nNodes;
+        nNodes += 2;
+    }
+
+    this->nodes[node].leaf = false;
+    this->nodes[node].radius = tuples[middle].first;
+    this->nodes[node].inner = inner;
+    this->nodes[node].outer = inner + 1;
+
+#pragma omp task shared(dataTraining, tuples, nNodes, config) if (middle - begin > VPTREE_TASK_SIZE)
+    this->build(dataTraining, tuples, begin + 1, middle, inner, nNodes, config);
+#pragma omp task shared(dataTraining, tuples, nNodes, config) if (end - middle > VPTREE_TASK_SIZE)
+    this->build(dataTraining, tuples, middle, end, inner + 1, nNodes, config);
+#pragma omp taskwait
+}
+
+void VPTree::search(unsigned int node, std::vector<float>& dataTest, unsigned int ptrDataTest, unsigned int k, std::priority_queue<std::pair<float, unsigned int>>& heap) const {
+    const Node& current = this->nodes[node];
+
+    for (unsigned int i = current.begin; i < (current.leaf ? current.end : current.begin + 1); ++i) {
+        std::pair<float, unsigned int> candidate(this->distanceFunction(this->points, dataTest, i * this->nFeatures, ptrDataTest, this->nFeatures), this->indexes[i]);
+        if (heap.size() < k) {
+            heap.push(candidate);
+        } else if (candidate < heap.top()) {
+            heap.pop();
+            heap.push(candidate);
+        }
+    }
+    if (current.leaf) {
+        return;
+    }
+
+    // By the triangle inequality the tuples of inner are at >= distance - radius of the test tuple
+    // and the ones of outer at >= radius - distance, the child of the test tuple is searched first
+    float distance = this->distanceFunction(this->points, dataTest, current.begin * this->nFeatures, ptrDataTest, this->nFeatures);
+    float slack = VPTREE_PRUNE_SLACK * (distance + current.radius);
+    bool innerFirst = distance < current.radius;
+    for (unsigned int child = 0; child < 2; ++child) {
+        bool inner = innerFirst == (child == 0);
+        float bound = inner ? distance - current.radius : current.radius - distance;
+        if (heap.size() < k || bound <= heap.top().first + slack) {
+            this->search(inner ? current.inner : current.outer, dataTest, ptrDataTest, k, heap);
+        }
+    }
+}
+
+std::vector<std::pair<float, unsigned int>> VPTree::getNearestTuples(std::vector<float>& dataTest, unsigned int ptrDataTest, unsigned int k) const {
+    std::priority_queue<std::pair<float, unsigned int>> heap;
+    if (!this->nodes.empty() && k) {
+        this->search(0, dataTest, ptrDataTest, k, heap);
+    }
+
+    std::vector<std::pair<float, unsigned int>> neighbors(heap.size());
+    for (auto it = neighbors.rbegin(); it != neighbors.rend(); ++it) {
+        *it = heap.top();
+        heap.pop();
+    }
+
+    return neighbors;
+}
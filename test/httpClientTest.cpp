@@ -0,0 +1,48 @@
+/**
+ * This file is subject to the terms and conditions defined in
+ * file 'LICENSE', which is part of Hpknn repository.
+ *
+ * This work has been funded by:
+ *
+ * Spanish 'Ministerio de Economía y Competitividad' under grants number
+ * TIN2012-32039 and TIN2015-67020-P.\n Spanish 'Ministerio de Ciencia,
+ * Innovación y Universidades' under grant number PGC2018-098813-B-C31.\n
+ * European Regional Development Fund (ERDF).
+ *
+ * @file httpClientTest.cpp
+ * @author Francisco Rodríguez Jiménez
+ * @date 19/10/2026
+ * @brief Do GET requests with one HttpClient, used by httpClientTest.sh against local TLS servers
+ * @copyright Hpknn (c) 2015 EFFICOMP
+ */
+
+/********************************* Includes *******************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "httpClient.h"
+
+/********************************* Methods ********************************/
+
+/**
+ * @brief Main, the arguments are host, port, CA file and the paths requested one after the other.
+ * Each response is printed as a line with the path, the status, the X-Connection header and the body
+ * @return EXIT_SUCCESS if the server answered every request with status 200, EXIT_FAILURE otherwise
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 5) {
+        fprintf(stderr, "Usage: %s host port caFile path...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    HttpClient client(argv[1], atoi(argv[2]), argv[3]);
+    bool success = true;
+    for (int i = 4; i < argc; ++i) {
+        HttpResponse response = client.get(argv[i]);
+        auto connection = response.headers.find("x-connection");
+        printf("%s %d %s %s\n", argv[i], response.status, connection != response.headers.end() ? connection->second.c_str() : "-",
+               response.body.c_str());
+        success = success && response.status == 200;
+    }
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
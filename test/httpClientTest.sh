@@ -0,0 +1,68 @@
+#!/bin/bash
+# This file is subject to the terms and conditions defined in
+# file 'LICENSE', which is part of Hpknn repository.
+#
+# @file httpClientTest.sh
+# @author Francisco Rodríguez Jiménez
+# @date 19/10/2026
+# @brief Check HttpClient against local TLS servers. With openssl s_server, the request succeeds
+# with the CA and host of the certificate, and fails with another CA or another host. With
+# httpServer.py, the framing by Content-Length and chunks, the reuse of the connection, the retry
+# of a request on a stale connection and the timeout of a server that stalls
+# @copyright Hpknn (c) 2015 EFFICOMP
+
+# ************ Vars ************
+CLIENT=${1:-bin/httpClientTest}
+PORT=${2:-44330}
+SCRIPTED_PORT=$((PORT + 1))
+DIR=$(mktemp -d)
+FAILED=0
+
+# ************ Certificates ************
+# One certificate for localhost and another one that has not issued it
+for NAME in server other; do
+    openssl req -x509 -newkey rsa:2048 -nodes -days 1 -subj "/CN=localhost" \
+        -addext "subjectAltName=DNS:localhost" -keyout $DIR/$NAME.key -out $DIR/$NAME.pem 2>/dev/null
+done
+
+openssl s_server -quiet -www -accept $PORT -cert $DIR/server.pem -key $DIR/server.key >/dev/null 2>&1 &
+SERVER=$!
+python3 $(dirname $0)/httpServer.py $SCRIPTED_PORT $DIR/server.pem $DIR/server.key &
+SCRIPTED=$!
+trap "kill $SERVER $SCRIPTED; rm -rf $DIR" EXIT
+sleep 1
+
+# ************ Cases ************
+expect() {
+    if [ "$1" = "$2" ]; then
+        echo -e "\e[32mPASS\e[0m $3"
+    else
+        echo -e "\e[31mFAIL\e[0m $3"
+        FAILED=1
+    fi
+}
+
+$CLIENT localhost $PORT $DIR/server.pem / >/dev/null 2>&1
+expect $? 0 "trusted certificate of the host"
+$CLIENT localhost $PORT $DIR/other.pem / >/dev/null 2>&1
+expect $? 1 "certificate of another CA is rejected"
+$CLIENT 127.0.0.1 $PORT $DIR/server.pem / >/dev/null 2>&1
+expect $? 1 "certificate of another host is rejected"
+$CLIENT localhost $PORT $DIR/missing.pem / >/dev/null 2>&1
+expect $? 1 "missing CA file is an error"
+
+# Each line is the path, status, connection and body
+request() {
+    $CLIENT localhost $SCRIPTED_PORT $DIR/server.pem "$@" 2>/dev/null | tr '\n' ' ' | tr -s ' '
+}
+
+expect "$(request /length /chunked)" "/length 200 1 length-body /chunked 200 1 chunk-body-split " \
+    "Content-Length and chunks with extensions and trailers, in a reused connection"
+expect "$(request /close /length)" "/close 200 2 close-body /length 200 3 length-body " \
+    "Connection: Close opens a new connection for the next request"
+expect "$(request /stale /stale)" "/stale 200 4 stale-body /stale 200 5 stale-body " \
+    "a request in a stale connection is retried once in a new one"
+expect "$(request /stall /length)" "/stall -1 - /length 200 7 length-body " \
+    "a server that stalls makes the request fail after the timeout"
+
+exit $FAILED
@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+# This file is subject to the terms and conditions defined in
+# file 'LICENSE', which is part of Hpknn repository.
+#
+# @file httpServer.py
+# @author Francisco Rodríguez Jiménez
+# @date 19/10/2026
+# @brief TLS server with canned responses for httpClientTest.sh. Each path exercises a part of
+# HttpClient, and the X-Connection header numbers the connections to check that they are reused
+# @copyright Hpknn (c) 2015 EFFICOMP
+
+import socket
+import ssl
+import sys
+import threading
+import time
+
+PORT, CERT, KEY = int(sys.argv[1]), sys.argv[2], sys.argv[3]
+connections = 0
+lock = threading.Lock()
+
+
+def respond(conn, number, path, served, closing):
+    head = 'HTTP/1.1 200 OK\r\nX-Connection: %d\r\n' % number
+    if closing:
+        # A client that ignores Connection: Close gets this answer instead of a new connection
+        body = 'after-close'
+        conn.sendall((head + 'Content-Length: %d\r\n\r\n%s' % (len(body), body)).encode())
+        return False
+    elif path == '/length':
+        body = 'length-body'
+        conn.sendall((head + 'Content-Length: %d\r\n\r\n%s' % (len(body), body)).encode())
+    elif path == '/chunked':
+        # Chunk extensions and trailers must be skipped
+        conn.sendall((head + 'Transfer-Encoding: Chunked\r\n\r\n'
+                      '6;name=value\r\nchunk-\r\n'
+                      'a\r\nbody-split\r\n'
+                      '0\r\nX-Trailer: ignored\r\n\r\n').encode())
+    elif path == '/close':
+        body = 'close-body'
+        conn.sendall((head + 'Connection: Close\r\nContent-Length: %d\r\n\r\n%s' % (len(body), body)).encode())
+        return None
+    elif path == '/stale':
+        # A reused connection is closed without answering, as a server that drops idle ones
+        if served:
+            return False
+        body = 'stale-body'
+        conn.sendall((head + 'Content-Length: %d\r\n\r\n%s' % (len(body), body)).encode())
+    elif path == '/stall':
+        time.sleep(30)
+        return False
+    else:
+        conn.sendall(b'HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n')
+    return True
+
+
+def serve(conn):
+    global connections
+    with lock:
+        connections += 1
+        number = connections
+
+    served = 0
+    closing = False
+    data = b''
+    try:
+        while True:
+            while b'\r\n\r\n' not in data:
+                received = conn.recv(4096)
+                if not received:
+                    return
+                data += received
+            request, data = data.split(b'\r\n\r\n', 1)
+            path = request.split(b' ')[1].decode()
+            # None keeps the connection open after announcing Connection: Close
+            answer = respond(conn, number, path, served, closing)
+            if answer is False:
+                return
+            closing = answer is None
+            served += 1
+    except (OSError, ssl.SSLError):
+        pass
+    finally:
+        conn.close()
+
+
+context = ssl.SSLContext(ssl.PROTOCOL_TLS_SERVER)
+context.load_cert_chain(CERT, KEY)
+server = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+server.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+server.bind(('127.0.0.1', PORT))
+server.listen(8)
+
+while True:
+    conn, _ = server.accept()
+    try:
+        conn = context.wrap_socket(conn, server_side=True)
+    except (OSError, ssl.SSLError):
+        conn.close()
+        continue
+    threading.Thread(target=serve, args=(conn,), daemon=True).start()